@@ -1,6 +1,16 @@
 #include "chess_analyzer.h"
 #include <iostream>
+#include <atomic>
 #include <chrono>
+#include <deque>
+#include <fstream>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
 #include <vector>
 
 using namespace chess;
@@ -18,25 +28,221 @@ struct PerftResult {
     uint64_t checkmates;
 };
 
+// Fast perft: the number of legal moves at depth 1 is the leaf count, so
+// the last ply is never made on the board
+uint64_t perftBulk(Position& pos, int depth, const MoveGenerator& generator) {
+    MoveList moves;
+    generator.generateLegalMoves(pos, moves);
+    
+    if (depth <= 1) {
+        return moves.size();
+    }
+    
+    uint64_t nodes = 0;
+    for (const Move& move : moves) {
+        pos.doMove(move);
+        nodes += perftBulk(pos, depth - 1, generator);
+        pos.undoMove();
+    }
+    return nodes;
+}
+
+// Fixed-size node-count cache shared by all perft threads without locks.
+// Each entry stores (hash ^ data, data) where data packs the node count and
+// depth; a torn read or write from a racing thread fails the XOR check and
+// is treated as a miss, so counts never come from a mixed entry.
+class PerftHashTable {
+public:
+    explicit PerftHashTable(size_t megabytes) {
+        size_t buckets = 1;
+        while (buckets * 2 * sizeof(Bucket) <= megabytes * 1024 * 1024) {
+            buckets *= 2;
+        }
+        table = std::vector<Bucket>(buckets);
+        mask = buckets - 1;
+    }
+    
+    bool probe(uint64_t hash, int depth, uint64_t& nodes) const {
+        const Bucket& bucket = table[hash & mask];
+        for (const Entry& entry : bucket.entries) {
+            uint64_t data = entry.data.load(std::memory_order_relaxed);
+            uint64_t check = entry.check.load(std::memory_order_relaxed);
+            if ((check ^ data) == hash && int(data & DEPTH_MASK) == depth) {
+                nodes = data >> DEPTH_BITS;
+                return true;
+            }
+        }
+        return false;
+    }
+    
+    // Overwrite the entry for the same position and depth if present,
+    // otherwise the shallowest one; deep subtrees are the expensive ones
+    void store(uint64_t hash, int depth, uint64_t nodes) {
+        Bucket& bucket = table[hash & mask];
+        Entry* replace = &bucket.entries[0];
+        for (Entry& entry : bucket.entries) {
+            uint64_t data = entry.data.load(std::memory_order_relaxed);
+            uint64_t check = entry.check.load(std::memory_order_relaxed);
+            if ((check ^ data) == hash && int(data & DEPTH_MASK) == depth) {
+                replace = &entry;
+                break;
+            }
+            if ((data & DEPTH_MASK) < (replace->data.load(std::memory_order_relaxed) & DEPTH_MASK)) {
+                replace = &entry;
+            }
+        }
+        
+        uint64_t data = (nodes << DEPTH_BITS) | uint64_t(depth);
+        replace->check.store(hash ^ data, std::memory_order_relaxed);
+        replace->data.store(data, std::memory_order_relaxed);
+    }
+    
+    void clear() {
+        for (Bucket& bucket : table) {
+            for (Entry& entry : bucket.entries) {
+                entry.check.store(0, std::memory_order_relaxed);
+                entry.data.store(0, std::memory_order_relaxed);
+            }
+        }
+    }
+    
+    size_t sizeInBytes() const { return table.size() * sizeof(Bucket); }
+
+private:
+    static constexpr int DEPTH_BITS = 8;
+    static constexpr uint64_t DEPTH_MASK = (1ULL << DEPTH_BITS) - 1;
+    
+    struct Entry {
+        std::atomic<uint64_t> check{0};
+        std::atomic<uint64_t> data{0};
+    };
+    
+    // Four entries fill one cache line, so a probe touches a single line
+    struct alignas(64) Bucket {
+        Entry entries[4];
+    };
+    
+    std::vector<Bucket> table;
+    size_t mask;
+};
+
+// Bulk-counting perft that looks up and stores subtree counts by position
+uint64_t perftHashed(Position& pos, int depth, const MoveGenerator& generator, PerftHashTable& table) {
+    if (depth <= 1) {
+        return perftBulk(pos, depth, generator);
+    }
+    
+    uint64_t nodes = 0;
+    if (table.probe(pos.getHash(), depth, nodes)) {
+        return nodes;
+    }
+    
+    MoveList moves;
+    generator.generateLegalMoves(pos, moves);
+    for (const Move& move : moves) {
+        pos.doMove(move);
+        nodes += perftHashed(pos, depth - 1, generator, table);
+        pos.undoMove();
+    }
+    
+    table.store(pos.getHash(), depth, nodes);
+    return nodes;
+}
+
+// Runs a fixed set of tasks on a few threads. Every worker owns a deque and
+// takes from its back; a worker that runs dry steals from the front of the
+// others, so uneven subtrees still keep every core busy.
+class WorkStealingPool {
+public:
+    explicit WorkStealingPool(unsigned threadCount) : queues(threadCount > 0 ? threadCount : 1) {}
+    
+    void run(size_t taskCount, const std::function<void(size_t task)>& work) {
+        // Deal tasks round-robin so every worker starts with a share
+        for (size_t i = 0; i < taskCount; ++i) {
+            queues[i % queues.size()].tasks.push_back(i);
+        }
+        
+        std::vector<std::thread> threads;
+        for (unsigned worker = 0; worker < queues.size(); ++worker) {
+            threads.emplace_back([this, worker, &work] {
+                size_t task;
+                while (popLocal(worker, task) || steal(worker, task)) {
+                    work(task);
+                }
+            });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+    }
+    
+    unsigned size() const { return static_cast<unsigned>(queues.size()); }
+
+private:
+    struct WorkQueue {
+        std::mutex mutex;
+        std::deque<size_t> tasks;
+    };
+    
+    bool popLocal(unsigned worker, size_t& task) {
+        WorkQueue& queue = queues[worker];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (queue.tasks.empty()) return false;
+        task = queue.tasks.back();
+        queue.tasks.pop_back();
+        return true;
+    }
+    
+    bool steal(unsigned thief, size_t& task) {
+        for (size_t i = 1; i < queues.size(); ++i) {
+            WorkQueue& victim = queues[(thief + i) % queues.size()];
+            std::lock_guard<std::mutex> lock(victim.mutex);
+            if (!victim.tasks.empty()) {
+                task = victim.tasks.front();
+                victim.tasks.pop_front();
+                return true;
+            }
+        }
+        return false;
+    }
+    
+    std::vector<WorkQueue> queues;
+};
+
+struct TestPosition {
+    std::string name;
+    std::string fen;
+    std::vector<uint64_t> expectedNodes;  // Expected nodes at each depth from depth 0; 0 if unknown
+};
+
 class PerftTester {
 public:
-    PerftResult perft(const Position& pos, int depth) {
+    PerftTester(unsigned threads, int maxDepth, bool detailed, size_t hashMegabytes)
+        : pool(threads), maxDepth(maxDepth), detailed(detailed) {
+        if (hashMegabytes > 0) {
+            hashTable = std::make_unique<PerftHashTable>(hashMegabytes);
+        }
+    }
+    
+    // Slow perft with a breakdown of move types; only used in detailed mode
+    PerftResult perft(Position& pos, int depth) {
         if (depth == 0) {
             return {1, 0, 0, 0, 0, 0, 0};
         }
         
         PerftResult result = {0, 0, 0, 0, 0, 0, 0};
-        ChessAnalyzer analyzer;
-        std::vector<Move> moves = analyzer.generateMoves(pos);
+        MoveList moves;
+        generator.generateLegalMoves(pos, moves);
         
         for (const Move& move : moves) {
-            Position newPos = pos.makeMove(move);
+            bool capture = pos.getPieceAt(move.to()) != NO_PIECE;
+            pos.doMove(move);
             
             if (depth == 1) {
                 result.nodes++;
                 
                 // Count move types
-                if (pos.getPieceAt(move.to()) != NO_PIECE) {
+                if (capture) {
                     result.captures++;
                 }
                 if (move.isEnPassant()) {
@@ -48,17 +254,18 @@ public:
                 if (move.isPromotion()) {
                     result.promotions++;
                 }
-                if (newPos.isInCheck()) {
+                if (pos.isInCheck()) {
                     result.checks++;
                 }
                 
                 // Check for checkmate
-                std::vector<Move> replies = analyzer.generateMoves(newPos);
-                if (replies.empty() && newPos.isInCheck()) {
+                MoveList replies;
+                generator.generateLegalMoves(pos, replies);
+                if (replies.empty() && pos.isInCheck()) {
                     result.checkmates++;
                 }
             } else {
-                PerftResult subResult = perft(newPos, depth - 1);
+                PerftResult subResult = perft(pos, depth - 1);
                 result.nodes += subResult.nodes;
                 result.captures += subResult.captures;
                 result.enPassant += subResult.enPassant;
@@ -67,115 +274,453 @@ public:
                 result.checks += subResult.checks;
                 result.checkmates += subResult.checkmates;
             }
+            
+            pos.undoMove();
         }
         
         return result;
     }
     
-    void runPerftSuite() {
-        struct TestPosition {
-            std::string name;
-            std::string fen;
-            std::vector<uint64_t> expectedNodes;  // Expected nodes at each depth
-        };
-        
-        std::vector<TestPosition> testPositions = {
-            {
-                "Starting Position",
-                "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1",
-                {1, 20, 400, 8902, 197281, 4865609}
-            },
-            {
-                "Kiwipete",
-                "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
-                {1, 48, 2039, 97862, 4085603}
-            },
-            {
-                "Position 3",
-                "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1",
-                {1, 14, 191, 2812, 43238, 674624}
-            },
-            {
-                "Position 4",
-                "r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1",
-                {1, 6, 264, 9467, 422333}
-            },
-            {
-                "Position 5",
-                "rnbq1k1r/pp1Pbppp/2p5/8/2B5/8/PPP1NnPP/RNBQK2R w KQ - 1 8",
-                {1, 44, 1486, 62379, 2103487}
+    // Bulk-counting perft with the tree split into subtrees across the pool
+    uint64_t parallelPerft(const Position& root, int depth) {
+        if (depth == 0) return 1;
+        
+        uint64_t nodes = 0;
+        for (const PerftTask& task : runTasks(root, depth)) {
+            nodes += task.nodes;
+        }
+        return nodes;
+    }
+    
+    // Node counts below each root move, in generation order
+    std::vector<std::pair<Move, uint64_t>> divide(const Position& root, int depth) {
+        std::vector<std::pair<Move, uint64_t>> counts;
+        if (depth < 1) return counts;
+        
+        Position pos = root;
+        MoveList rootMoves;
+        generator.generateLegalMoves(pos, rootMoves);
+        for (const Move& move : rootMoves) {
+            counts.emplace_back(move, 0);
+        }
+        
+        // Subtrees may be split below the root, so fold them back by first move
+        for (const PerftTask& task : runTasks(root, depth)) {
+            for (auto& count : counts) {
+                if (count.first == task.path.front()) {
+                    count.second += task.nodes;
+                    break;
+                }
             }
-        };
+        }
+        return counts;
+    }
+    
+    // Runs every depth of every position; returns false if any count is wrong
+    bool runSuite(const std::vector<TestPosition>& positions, bool json) {
+        bool allPassed = true;
         
-        std::cout << "PERFT TEST SUITE\n";
-        std::cout << "================\n\n";
+        if (json) {
+            std::cout << "{\n";
+            std::cout << "  \"mode\": \"" << (detailed ? "detailed" : "bulk") << "\",\n";
+            std::cout << "  \"threads\": " << (detailed ? 1 : pool.size()) << ",\n";
+            std::cout << "  \"hash_mb\": " << hashMegabytes() << ",\n";
+            std::cout << "  \"positions\": [";
+        } else {
+            std::cout << "PERFT TEST SUITE\n";
+            std::cout << "================\n";
+            std::cout << "Mode: " << (detailed ? "detailed (single thread)" : "bulk counting")
+                      << ", threads: " << (detailed ? 1 : pool.size());
+            if (hashMegabytes() > 0) {
+                std::cout << ", hash: " << hashMegabytes() << " MB";
+            }
+            std::cout << "\n\n";
+        }
         
-        for (const auto& test : testPositions) {
-            std::cout << "Testing: " << test.name << "\n";
-            std::cout << "FEN: " << test.fen << "\n\n";
+        for (size_t index = 0; index < positions.size(); ++index) {
+            const TestPosition& test = positions[index];
+            
+            if (json) {
+                std::cout << (index > 0 ? ",\n" : "\n");
+                std::cout << "    {\n";
+                std::cout << "      \"name\": " << jsonString(test.name) << ",\n";
+                std::cout << "      \"fen\": " << jsonString(test.fen) << ",\n";
+                std::cout << "      \"results\": [";
+            } else {
+                std::cout << "Testing: " << test.name << "\n";
+                std::cout << "FEN: " << test.fen << "\n\n";
+            }
             
             Position pos(test.fen);
+            bool firstResult = true;
             
-            for (size_t depth = 1; depth <= test.expectedNodes.size() && depth <= 5; ++depth) {
-                auto start = high_resolution_clock::now();
-                PerftResult result = perft(pos, depth);
-                auto end = high_resolution_clock::now();
-                auto duration = duration_cast<milliseconds>(end - start);
+            for (size_t depth = 1; depth < test.expectedNodes.size() && depth <= size_t(maxDepth); ++depth) {
+                if (test.expectedNodes[depth] == 0) continue;  // Depth not listed for this position
                 
-                bool passed = (result.nodes == test.expectedNodes[depth - 1]);
+                PerftResult result = {0, 0, 0, 0, 0, 0, 0};
                 
-                std::cout << "Depth " << depth << ": ";
-                std::cout << result.nodes << " nodes";
+                auto start = steady_clock::now();
+                if (detailed) {
+                    result = perft(pos, depth);
+                } else {
+                    result.nodes = parallelPerft(pos, depth);
+                }
+                auto end = steady_clock::now();
+                double ms = duration_cast<microseconds>(end - start).count() / 1000.0;
+                uint64_t nps = ms > 0 ? uint64_t(result.nodes * 1000.0 / ms) : 0;
                 
-                if (depth <= test.expectedNodes.size()) {
-                    std::cout << " (expected: " << test.expectedNodes[depth - 1] << ")";
-                    std::cout << " [" << (passed ? "PASS" : "FAIL") << "]";
+                bool passed = (result.nodes == test.expectedNodes[depth]);
+                allPassed = allPassed && passed;
+                
+                if (json) {
+                    std::cout << (firstResult ? "\n" : ",\n");
+                    std::cout << "        {\"depth\": " << depth
+                              << ", \"nodes\": " << result.nodes
+                              << ", \"expected\": " << test.expectedNodes[depth]
+                              << ", \"passed\": " << (passed ? "true" : "false")
+                              << ", \"time_ms\": " << ms
+                              << ", \"nps\": " << nps;
+                    if (detailed) {
+                        std::cout << ", \"captures\": " << result.captures
+                                  << ", \"en_passant\": " << result.enPassant
+                                  << ", \"castles\": " << result.castles
+                                  << ", \"promotions\": " << result.promotions
+                                  << ", \"checks\": " << result.checks
+                                  << ", \"checkmates\": " << result.checkmates;
+                    }
+                    std::cout << "}";
+                    firstResult = false;
+                    continue;
                 }
                 
-                std::cout << " - " << duration.count() << " ms";
+                std::cout << "Depth " << depth << ": ";
+                std::cout << result.nodes << " nodes";
+                std::cout << " (expected: " << test.expectedNodes[depth] << ")";
+                std::cout << " [" << (passed ? "PASS" : "FAIL") << "]";
+                std::cout << " - " << uint64_t(ms) << " ms";
                 
-                if (duration.count() > 0) {
-                    uint64_t nps = (result.nodes * 1000) / duration.count();
+                if (nps > 0) {
                     std::cout << " (" << nps << " nps)";
                 }
                 
                 std::cout << "\n";
                 
+                if (detailed) {
+                    std::cout << "  Captures: " << result.captures << "\n";
+                    std::cout << "  En passant: " << result.enPassant << "\n";
+                    std::cout << "  Castles: " << result.castles << "\n";
+                    std::cout << "  Promotions: " << result.promotions << "\n";
+                    std::cout << "  Checks: " << result.checks << "\n";
+                    std::cout << "  Checkmates: " << result.checkmates << "\n";
+                }
+                
                 if (!passed) {
                     std::cout << "ERROR: Node count mismatch!\n";
-                    // Detailed breakdown for debugging
-                    if (depth == 1) {
-                        std::cout << "  Captures: " << result.captures << "\n";
-                        std::cout << "  En passant: " << result.enPassant << "\n";
-                        std::cout << "  Castles: " << result.castles << "\n";
-                        std::cout << "  Promotions: " << result.promotions << "\n";
-                        std::cout << "  Checks: " << result.checks << "\n";
-                    }
                 }
             }
             
-            std::cout << "\n";
+            if (json) {
+                std::cout << "\n      ]\n    }";
+            } else {
+                std::cout << "\n";
+            }
+        }
+        
+        if (json) {
+            std::cout << "\n  ],\n";
+            std::cout << "  \"passed\": " << (allPassed ? "true" : "false") << "\n";
+            std::cout << "}\n";
+        }
+        
+        return allPassed;
+    }
+    
+    void runDivide(const std::string& fen, int depth, bool json) {
+        Position pos(fen);
+        
+        auto start = steady_clock::now();
+        auto counts = divide(pos, depth);
+        auto end = steady_clock::now();
+        double ms = duration_cast<microseconds>(end - start).count() / 1000.0;
+        
+        uint64_t total = 0;
+        for (const auto& count : counts) {
+            total += count.second;
+        }
+        
+        if (json) {
+            std::cout << "{\n";
+            std::cout << "  \"fen\": " << jsonString(fen) << ",\n";
+            std::cout << "  \"depth\": " << depth << ",\n";
+            std::cout << "  \"moves\": {";
+            for (size_t i = 0; i < counts.size(); ++i) {
+                std::cout << (i > 0 ? ",\n" : "\n") << "    \"" << counts[i].first.toUCI()
+                          << "\": " << counts[i].second;
+            }
+            std::cout << "\n  },\n";
+            std::cout << "  \"nodes\": " << total << ",\n";
+            std::cout << "  \"time_ms\": " << ms << "\n";
+            std::cout << "}\n";
+            return;
+        }
+        
+        for (const auto& count : counts) {
+            std::cout << count.first.toUCI() << ": " << count.second << "\n";
+        }
+        std::cout << "\nMoves: " << counts.size() << "\n";
+        std::cout << "Nodes: " << total << "\n";
+        std::cout << "Time: " << uint64_t(ms) << " ms\n";
+    }
+
+private:
+    // A subtree of the perft tree: the moves leading to it and the depth left below it
+    struct PerftTask {
+        std::vector<Move> path;
+        int depth;
+        uint64_t nodes;
+    };
+    
+    std::vector<PerftTask> runTasks(const Position& root, int depth) {
+        std::vector<PerftTask> tasks = splitTree(root, depth);
+        
+        // Start from an empty cache so timings do not depend on earlier runs
+        PerftHashTable* table = hashTable.get();
+        if (table) {
+            table->clear();
         }
+        
+        pool.run(tasks.size(), [&root, &tasks, table](size_t index) {
+            PerftTask& task = tasks[index];
+            MoveGenerator localGenerator;
+            Position pos = root;
+            for (const Move& move : task.path) {
+                pos.doMove(move);
+            }
+            if (task.depth == 0) {
+                task.nodes = 1;
+            } else if (table) {
+                task.nodes = perftHashed(pos, task.depth, localGenerator, *table);
+            } else {
+                task.nodes = perftBulk(pos, task.depth, localGenerator);
+            }
+        });
+        
+        return tasks;
+    }
+    
+    // Split at the root, or one ply deeper when there are too few root moves
+    // to keep every thread busy
+    std::vector<PerftTask> splitTree(const Position& root, int depth) {
+        Position pos = root;
+        MoveList rootMoves;
+        generator.generateLegalMoves(pos, rootMoves);
+        
+        int splitPlies = (depth > 3 && rootMoves.size() < size_t(pool.size()) * 4) ? 2 : 1;
+        
+        std::vector<PerftTask> tasks;
+        std::vector<Move> path;
+        collectTasks(pos, depth, splitPlies, path, tasks);
+        return tasks;
     }
+    
+    void collectTasks(Position& pos, int depth, int splitPlies,
+                      std::vector<Move>& path, std::vector<PerftTask>& tasks) {
+        if (splitPlies == 0 || depth == 0) {
+            tasks.push_back({path, depth, 0});
+            return;
+        }
+        
+        MoveList moves;
+        generator.generateLegalMoves(pos, moves);
+        for (const Move& move : moves) {
+            path.push_back(move);
+            pos.doMove(move);
+            collectTasks(pos, depth - 1, splitPlies - 1, path, tasks);
+            pos.undoMove();
+            path.pop_back();
+        }
+    }
+    
+    size_t hashMegabytes() const {
+        return (hashTable && !detailed) ? hashTable->sizeInBytes() / (1024 * 1024) : 0;
+    }
+    
+    static std::string jsonString(const std::string& text) {
+        std::string quoted = "\"";
+        for (char ch : text) {
+            if (ch == '"' || ch == '\\') quoted += '\\';
+            quoted += ch;
+        }
+        return quoted + "\"";
+    }
+    
+    MoveGenerator generator;
+    WorkStealingPool pool;
+    std::unique_ptr<PerftHashTable> hashTable;
+    int maxDepth;
+    bool detailed;
 };
 
-int main() {
-    std::cout << "Chess Move Analyzer - Performance Test (Perft)\n";
-    std::cout << "=============================================\n\n";
+// The standard positions from the Chess Programming Wiki perft results page
+std::vector<TestPosition> builtinSuite() {
+    return {
+        {
+            "Starting Position",
+            "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1",
+            {1, 20, 400, 8902, 197281, 4865609, 119060324, 3195901860}
+        },
+        {
+            "Kiwipete",
+            "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+            {1, 48, 2039, 97862, 4085603, 193690690}
+        },
+        {
+            "Position 3",
+            "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1",
+            {1, 14, 191, 2812, 43238, 674624, 11030083, 178633661}
+        },
+        {
+            "Position 4",
+            "r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1",
+            {1, 6, 264, 9467, 422333, 15833292, 706045033}
+        },
+        {
+            "Position 5",
+            "rnbq1k1r/pp1Pbppp/2p5/8/2B5/8/PPP1NnPP/RNBQK2R w KQ - 1 8",
+            {1, 44, 1486, 62379, 2103487, 89941194}
+        }
+    };
+}
+
+// Reads a perftsuite EPD file: a FEN (or its first four fields) followed by
+// ";D<depth> <nodes>" fields, one position per line
+std::vector<TestPosition> loadEpd(const std::string& path) {
+    std::ifstream file(path);
+    if (!file) {
+        throw std::runtime_error("Cannot open EPD file: " + path);
+    }
     
-    PerftTester tester;
+    std::vector<TestPosition> positions;
+    std::string line;
+    int lineNumber = 0;
+    
+    while (std::getline(file, line)) {
+        ++lineNumber;
+        if (line.empty() || line[0] == '#') continue;
+        
+        std::istringstream fields(line);
+        std::string field;
+        std::getline(fields, field, ';');
+        
+        // EPD omits the move counters; Position expects a full FEN
+        std::istringstream fenStream(field);
+        std::vector<std::string> fenParts;
+        std::string part;
+        while (fenStream >> part) {
+            fenParts.push_back(part);
+        }
+        if (fenParts.size() < 4) continue;
+        if (fenParts.size() == 4) {
+            fenParts.push_back("0");
+            fenParts.push_back("1");
+        }
+        
+        TestPosition test;
+        test.name = path + ":" + std::to_string(lineNumber);
+        for (size_t i = 0; i < 6; ++i) {
+            test.fen += (i > 0 ? " " : "") + fenParts[i];
+        }
+        test.expectedNodes = {1};
+        
+        while (std::getline(fields, field, ';')) {
+            std::istringstream op(field);
+            std::string depthToken;
+            uint64_t nodes = 0;
+            if (!(op >> depthToken >> nodes) || depthToken.size() < 2 || depthToken[0] != 'D') continue;
+            
+            size_t depth = std::stoul(depthToken.substr(1));
+            if (depth >= test.expectedNodes.size()) {
+                test.expectedNodes.resize(depth + 1, 0);
+            }
+            test.expectedNodes[depth] = nodes;
+        }
+        
+        positions.push_back(test);
+    }
+    
+    return positions;
+}
+
+void printUsage() {
+    std::cout << "Usage: perft [options]\n";
+    std::cout << "  --epd <file>     Run the positions of a perftsuite EPD file instead of the built-in suite\n";
+    std::cout << "  --divide <n>     Print node counts per root move at depth n\n";
+    std::cout << "  --fen <fen>      Position for --divide (default: starting position)\n";
+    std::cout << "  --json           Machine-readable output\n";
+    std::cout << "  --threads <n>    Worker threads (default: all cores)\n";
+    std::cout << "  --depth <n>      Maximum suite depth to run (default: 5)\n";
+    std::cout << "  --hash <mb>      Cache subtree counts in a shared table of this size (default: off)\n";
+    std::cout << "  --detailed       Single-threaded run with move type breakdown\n";
+}
+
+int main(int argc, char* argv[]) {
+    unsigned threads = std::thread::hardware_concurrency();
+    int maxDepth = 5;
+    bool detailed = false;
+    bool json = false;
+    size_t hashMegabytes = 0;
+    int divideDepth = 0;
+    std::string epdPath;
+    std::string fen = "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1";
+    
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--threads" && i + 1 < argc) {
+            threads = static_cast<unsigned>(std::stoi(argv[++i]));
+        } else if (arg == "--depth" && i + 1 < argc) {
+            maxDepth = std::stoi(argv[++i]);
+        } else if (arg == "--hash" && i + 1 < argc) {
+            hashMegabytes = static_cast<size_t>(std::stoul(argv[++i]));
+        } else if (arg == "--epd" && i + 1 < argc) {
+            epdPath = argv[++i];
+        } else if (arg == "--divide" && i + 1 < argc) {
+            divideDepth = std::stoi(argv[++i]);
+        } else if (arg == "--fen" && i + 1 < argc) {
+            fen = argv[++i];
+        } else if (arg == "--json") {
+            json = true;
+        } else if (arg == "--detailed") {
+            detailed = true;
+        } else {
+            printUsage();
+            return arg == "--help" ? 0 : 1;
+        }
+    }
+    
+    PerftTester tester(threads, maxDepth, detailed, hashMegabytes);
     
     try {
-        tester.runPerftSuite();
+        if (divideDepth > 0) {
+            tester.runDivide(fen, divideDepth, json);
+            return 0;
+        }
         
-        std::cout << "Performance test completed.\n";
-        std::cout << "\nNote: This implementation uses a simplified move generator.\n";
-        std::cout << "Full perft compliance requires complete chess rules implementation.\n";
+        std::vector<TestPosition> positions = epdPath.empty() ? builtinSuite() : loadEpd(epdPath);
+        
+        if (!json) {
+            std::cout << "Chess Move Analyzer - Performance Test (Perft)\n";
+            std::cout << "=============================================\n\n";
+        }
+        
+        bool passed = tester.runSuite(positions, json);
+        
+        if (!json) {
+            std::cout << "Performance test completed" << (passed ? ".\n" : " with failures.\n");
+        }
+        return passed ? 0 : 1;
         
     } catch (const std::exception& e) {
         std::cerr << "Error: " << e.what() << "\n";
         return 1;
     }
-    
-    return 0;
-} 
\ No newline at end of file
+}
\ No newline at end of file
@@ -6,6 +6,8 @@
 #include "chess_analyzer/evaluation/evaluator.h"
 #include "chess_analyzer/explanation/move_explainer.h"
 #include "chess_analyzer/notation/pgn_parser.h"
+#include "chess_analyzer/search/searcher.h"
+#include "chess_analyzer/search/search_handle.h"
 
 #include <string>
 #include <vector>
@@ -54,6 +56,91 @@ public:
      */
     Move findBestMove(const Position& position, int depth = 6) const;
 
+    /**
+     * @brief Rank the best moves in a position (MultiPV)
+     * @param position The position to analyze
+     * @param count Number of moves to rank (fewer if there are fewer legal moves)
+     * @param depth Search depth (default: 6)
+     * @return Moves with their scores and PVs, best first
+     */
+    std::vector<PVLine> findTopMoves(const Position& position, int count, int depth = 6) const;
+
+    /**
+     * @brief Search a position with iterative deepening until a limit is hit
+     * 
+     * The result always comes from the last fully completed iteration, so
+     * a time or node limit never returns a half-searched move.
+     * @param position The position to analyze
+     * @param limits Depth, time and node limits (zero fields are unlimited)
+     * @return Best move, score, principal variation and search effort
+     */
+    SearchResult search(const Position& position, const SearchLimits& limits) const;
+
+    /**
+     * @brief Start a search in the background and return at once
+     * 
+     * The handle reports each completed iteration, can stop the search and
+     * delivers the final result through a future. Searches started this
+     * way are only stopped through their handle, not by stopSearch(). The
+     * analyzer must outlive the handle. The thread count and search options
+     * are read when the search starts; changing them later affects only
+     * searches started afterwards.
+     * @param position The position to analyze (copied)
+     * @param limits Depth, time and node limits (zero fields are unlimited)
+     * @return Handle owning the running search
+     */
+    SearchHandle startSearch(const Position& position, const SearchLimits& limits) const;
+
+    /**
+     * @brief Ask running searches to finish as soon as possible
+     * 
+     * Safe to call from any thread; the stop flag is cleared when the next
+     * search starts.
+     */
+    void stopSearch() const;
+
+    /**
+     * @brief Resize the transposition table shared by all searches
+     * @param megabytes Table size (default: 16); existing entries are discarded
+     * 
+     * Waits for running searches to finish first, so stop any unlimited
+     * search before calling this.
+     */
+    void setHashSize(size_t megabytes);
+
+    /**
+     * @brief Forget all stored search results
+     * 
+     * Waits for running searches to finish first, like setHashSize().
+     */
+    void clearHash();
+
+    /**
+     * @brief Set the number of threads used by each search (Lazy SMP)
+     * 
+     * Extra threads search the same position at staggered depths and share
+     * the transposition table; the main thread's result is returned. A node
+     * limit applies to the nodes of all threads together.
+     * @param count Thread count (default: 1); values below 1 are treated as 1
+     */
+    void setThreads(int count);
+
+    /**
+     * @brief Get the number of threads used by each search
+     */
+    int getThreads() const;
+
+    /**
+     * @brief Tune or switch off search pruning (null move, late move reductions)
+     * @param options Settings used by subsequent searches
+     */
+    void setSearchOptions(const SearchOptions& options);
+
+    /**
+     * @brief Get the current search pruning settings
+     */
+    SearchOptions getSearchOptions() const;
+
     /**
      * @brief Analyze a complete game from PGN
      * @param pgn The PGN string of the game
@@ -2,6 +2,18 @@
 
 #include "chess_analyzer/core/types.h"
 
+#if defined(_MSC_VER) && defined(_M_X64)
+#include <immintrin.h>
+#endif
+
+// PEXT is only emitted on x86-64; it is selected at runtime, so the build
+// itself does not need -mbmi2
+#if defined(_M_X64) || (defined(__GNUC__) && defined(__x86_64__))
+#define CHESS_HAS_PEXT 1
+#else
+#define CHESS_HAS_PEXT 0
+#endif
+
 namespace chess {
 
 /**
@@ -49,17 +61,44 @@ constexpr Bitboard shift(Bitboard b) {
 
 // Ray generation for sliding pieces
 Bitboard getRay(Square from, Square to);
-Bitboard getBetween(Square from, Square to);
 
-// Attack generation helpers
-Bitboard pawnAttacksBB(Bitboard pawns, Color c);
-Bitboard knightAttacksBB(Square sq);
-Bitboard bishopAttacksBB(Square sq, Bitboard occupied);
-Bitboard rookAttacksBB(Square sq, Bitboard occupied);
-Bitboard queenAttacksBB(Square sq, Bitboard occupied);
-Bitboard kingAttacksBB(Square sq);
+// Precomputed square-pair tables, filled with the attack tables at startup
+extern Bitboard betweenTable[64][64];
+extern Bitboard lineTable[64][64];
+
+// Squares strictly between two aligned squares (0 if not on a common line)
+inline Bitboard getBetween(Square from, Square to) {
+    return betweenTable[from][to];
+}
 
-// Magic bitboard structures (for future optimization)
+// Whole board line through two aligned squares, edge to edge (0 if not aligned)
+inline Bitboard getLine(Square a, Square b) {
+    return lineTable[a][b];
+}
+
+// Sliding attack table indexing schemes
+enum class SlidingBackend : uint8_t {
+    MAGIC,  // Multiply-shift magic hashing, works everywhere
+    PEXT    // BMI2 parallel bit extract, only on CPUs with a fast PEXT
+};
+
+// Set at startup (or by setSlidingBackend), read on every sliding lookup
+extern bool slidingUsesPext;
+
+#if CHESS_HAS_PEXT
+inline Bitboard pextBB(Bitboard b, Bitboard mask) {
+#ifdef _MSC_VER
+    return _pext_u64(b, mask);
+#else
+    // Inline asm keeps this inlinable without compiling the caller for BMI2
+    Bitboard result;
+    __asm__("pextq %2, %1, %0" : "=r"(result) : "r"(b), "r"(mask));
+    return result;
+#endif
+}
+#endif
+
+// Magic bitboard entry for one square of a sliding piece
 struct MagicEntry {
     Bitboard mask;
     Bitboard magic;
@@ -67,6 +106,11 @@ struct MagicEntry {
     unsigned shift;
     
     unsigned index(Bitboard occupied) const {
+#if CHESS_HAS_PEXT
+        if (slidingUsesPext) {
+            return unsigned(pextBB(occupied, mask));
+        }
+#endif
         return unsigned(((occupied & mask) * magic) >> shift);
     }
 };
@@ -74,7 +118,48 @@ struct MagicEntry {
 extern MagicEntry rookMagics[64];
 extern MagicEntry bishopMagics[64];
 
-// Initialize magic bitboards (called once at startup)
+// Initialize magic bitboards (called once at startup, safe to call again).
+// Picks the PEXT backend when the CPU has a fast implementation of it.
 void initializeMagicBitboards();
 
-} // namespace chess 
\ No newline at end of file
+/**
+ * @brief Check whether this CPU supports BMI2 with a fast PEXT
+ *
+ * AMD before Zen 3 implements PEXT in microcode (hundreds of cycles),
+ * so those CPUs report false even though BMI2 is present.
+ */
+bool cpuHasFastPext();
+
+/**
+ * @brief Switch the sliding attack backend, rebuilding the shared tables
+ * @return false if the backend is not available on this CPU
+ *
+ * Not thread-safe: call before any search or move generation is running.
+ */
+bool setSlidingBackend(SlidingBackend backend);
+
+SlidingBackend getSlidingBackend();
+const char* slidingBackendName(SlidingBackend backend);
+
+// Attack generation helpers
+Bitboard pawnAttacksBB(Bitboard pawns, Color c);
+Bitboard pawnAttacksBB(Color c, Square sq);
+Bitboard knightAttacksBB(Square sq);
+Bitboard kingAttacksBB(Square sq);
+
+// Sliding attacks are a single magic table lookup, so keep them inline
+inline Bitboard bishopAttacksBB(Square sq, Bitboard occupied) {
+    const MagicEntry& m = bishopMagics[sq];
+    return m.attacks[m.index(occupied)];
+}
+
+inline Bitboard rookAttacksBB(Square sq, Bitboard occupied) {
+    const MagicEntry& m = rookMagics[sq];
+    return m.attacks[m.index(occupied)];
+}
+
+inline Bitboard queenAttacksBB(Square sq, Bitboard occupied) {
+    return bishopAttacksBB(sq, occupied) | rookAttacksBB(sq, occupied);
+}
+
+} // namespace chess
\ No newline at end of file
@@ -119,6 +119,15 @@ public:
      */
     uint16_t getRaw() const { return data; }
 
+    /**
+     * @brief Rebuild a move from data returned by getRaw()
+     */
+    static Move fromRaw(uint16_t raw) {
+        Move move;
+        move.data = raw;
+        return move;
+    }
+
 private:
     uint16_t data;
 
@@ -3,28 +3,61 @@
 #include "chess_analyzer/core/types.h"
 #include "chess_analyzer/core/position.h"
 #include "chess_analyzer/core/move.h"
+#include "chess_analyzer/core/move_list.h"
 #include <vector>
 #include <memory>
 
 namespace chess {
 
+/**
+ * @brief Move generation modes for MoveGenerator::generate
+ * 
+ * Every mode except PSEUDO_LEGAL emits only legal moves. CAPTURES and QUIETS
+ * partition the legal moves: queen promotions count as captures and
+ * under-promotions as quiet moves.
+ */
+enum GenType {
+    CAPTURES,      // Captures, en passant and queen promotions
+    QUIETS,        // Non-captures, including under-promotions and castling
+    EVASIONS,      // All legal moves; the side to move must be in check
+    QUIET_CHECKS,  // Non-capturing, non-promoting moves that give check
+    LEGAL,         // All legal moves
+    PSEUDO_LEGAL   // All moves, ignoring pins and checks
+};
+
 /**
  * @brief High-performance move generator using bitboards
  * 
  * This class generates all legal moves for a given position using
  * efficient bitboard algorithms including magic bitboards for sliding pieces.
+ * 
+ * Every generator has an overload that fills a stack-allocated MoveList;
+ * hot paths (search, perft) should use those. The vector-returning versions
+ * are kept for convenience and copy the result out of a MoveList.
  */
 class MoveGenerator {
 public:
     MoveGenerator();
     ~MoveGenerator();
 
+    /**
+     * @brief Append the moves of one generation mode to a move list
+     * 
+     * Each mode only builds the destinations it needs, so e.g. quiescence
+     * search can ask for CAPTURES without paying for full generation.
+     * @param position The position to generate moves for
+     * @param moves List the moves are appended to
+     */
+    template<GenType Type>
+    void generate(const Position& position, MoveList& moves) const;
+
     /**
      * @brief Generate all legal moves for a position
      * @param position The position to generate moves for
      * @return Vector of all legal moves
      */
     std::vector<Move> generateLegalMoves(const Position& position) const;
+    void generateLegalMoves(const Position& position, MoveList& moves) const;
 
     /**
      * @brief Generate all pseudo-legal moves (may leave king in check)
@@ -32,20 +65,23 @@ public:
      * @return Vector of pseudo-legal moves
      */
     std::vector<Move> generatePseudoLegalMoves(const Position& position) const;
+    void generatePseudoLegalMoves(const Position& position, MoveList& moves) const;
 
     /**
-     * @brief Generate only capture moves
+     * @brief Generate legal captures and queen promotions
      * @param position The position to generate moves for
      * @return Vector of capture moves
      */
     std::vector<Move> generateCaptures(const Position& position) const;
+    void generateCaptures(const Position& position, MoveList& moves) const;
 
     /**
-     * @brief Generate only quiet moves (non-captures)
+     * @brief Generate legal quiet moves (non-captures and under-promotions)
      * @param position The position to generate moves for
      * @return Vector of quiet moves
      */
     std::vector<Move> generateQuietMoves(const Position& position) const;
+    void generateQuietMoves(const Position& position, MoveList& moves) const;
 
     /**
      * @brief Check if a move is legal in the given position
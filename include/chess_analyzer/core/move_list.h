@@ -0,0 +1,95 @@
+#pragma once
+
+#include "chess_analyzer/core/move.h"
+#include <cstddef>
+#include <utility>
+
+namespace chess {
+
+/**
+ * @brief Upper bound on legal moves in any chess position (the known maximum is 218)
+ */
+constexpr size_t MAX_MOVES = 256;
+
+/**
+ * @brief Fixed-capacity move list that lives on the stack
+ * 
+ * Move generation fills one of these per node instead of allocating a
+ * std::vector. Each move has an optional ordering score that search can
+ * fill in; the generators leave scores untouched.
+ */
+class MoveList {
+public:
+    MoveList() : count(0) {}
+
+    /**
+     * @brief Append a move, constructed in place from Move constructor arguments
+     */
+    template<typename... Args>
+    void emplace_back(Args&&... args) {
+        moves[count++] = Move(std::forward<Args>(args)...);
+    }
+
+    void push_back(const Move& move) { moves[count++] = move; }
+
+    /**
+     * @brief Remove all moves
+     */
+    void clear() { count = 0; }
+
+    /**
+     * @brief Keep only the moves matching a predicate, preserving order
+     */
+    template<typename Predicate>
+    void filter(Predicate keep) {
+        size_t kept = 0;
+        for (size_t i = 0; i < count; ++i) {
+            if (keep(moves[i])) {
+                moves[kept++] = moves[i];
+            }
+        }
+        count = kept;
+    }
+
+    /**
+     * @brief Check if a move is in the list
+     */
+    bool contains(const Move& move) const {
+        for (size_t i = 0; i < count; ++i) {
+            if (moves[i] == move) return true;
+        }
+        return false;
+    }
+
+    size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+
+    Move& operator[](size_t i) { return moves[i]; }
+    const Move& operator[](size_t i) const { return moves[i]; }
+
+    /**
+     * @brief Ordering score of the i-th move (uninitialized until set)
+     */
+    int& score(size_t i) { return scores[i]; }
+    int score(size_t i) const { return scores[i]; }
+
+    /**
+     * @brief Swap two entries together with their scores
+     */
+    void swap(size_t i, size_t j) {
+        std::swap(moves[i], moves[j]);
+        std::swap(scores[i], scores[j]);
+    }
+
+    Move* begin() { return moves; }
+    Move* end() { return moves + count; }
+    const Move* begin() const { return moves; }
+    const Move* end() const { return moves + count; }
+
+private:
+    Move moves[MAX_MOVES];
+    int scores[MAX_MOVES];
+    size_t count;
+};
+
+} // namespace chess
\ No newline at end of file
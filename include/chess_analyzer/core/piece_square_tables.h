@@ -0,0 +1,38 @@
+#pragma once
+
+#include "chess_analyzer/core/types.h"
+
+namespace chess {
+
+// Piece values in centipawns
+namespace PieceValue {
+    constexpr int PAWN = 100;
+    constexpr int KNIGHT = 320;
+    constexpr int BISHOP = 330;
+    constexpr int ROOK = 500;
+    constexpr int QUEEN = 900;
+    constexpr int KING = 20000;
+}
+
+/**
+ * @brief Material values, piece-square bonuses and game-phase weights
+ * 
+ * Position keeps running sums of these as pieces are put on and taken off
+ * squares, so evaluation reads material, piece-square scores and the game
+ * phase without walking the board. Bonuses are packed middlegame/endgame
+ * pairs; black's are white's mirrored vertically. Tables are generated at
+ * compile time.
+ */
+struct PieceSquareTables {
+    int material[6];          // [piece_type], 0 for the king
+    int phase[6];             // [piece_type] weight in the game phase
+    Score psq[2][6][64];      // [color][piece_type][square]
+};
+
+// Game phase of the starting material: 4 minors, 4 rooks and 2 queens.
+// Evaluation is pure middlegame at this phase and pure endgame at 0.
+constexpr int MAX_PHASE = 24;
+
+extern const PieceSquareTables psqt;
+
+} // namespace chess
\ No newline at end of file
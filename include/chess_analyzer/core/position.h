@@ -1,8 +1,12 @@
 #pragma once
 
 #include "chess_analyzer/core/types.h"
+#include "chess_analyzer/core/move.h"
 #include <string>
 #include <array>
+#include <algorithm>
+#include <cassert>
+#include <vector>
 
 namespace chess {
 
@@ -31,27 +35,27 @@ public:
      * @param color The piece color
      * @return 64-bit bitboard with 1s where pieces are located
      */
-    Bitboard getPieceBitboard(PieceType piece, Color color) const;
+    Bitboard getPieceBitboard(PieceType piece, Color color) const { return pieceBitboards[color][piece]; }
 
     /**
      * @brief Get bitboard for all pieces of a specific color
      * @param color The piece color
      * @return Bitboard of all pieces of that color
      */
-    Bitboard getColorBitboard(Color color) const;
+    Bitboard getColorBitboard(Color color) const { return colorBitboards[color]; }
 
     /**
      * @brief Get bitboard of all occupied squares
      * @return Bitboard with 1s on all occupied squares
      */
-    Bitboard getOccupiedBitboard() const;
+    Bitboard getOccupiedBitboard() const { return occupiedBitboard; }
 
     /**
      * @brief Get the piece at a specific square
      * @param square The square to check (0-63)
      * @return The piece at that square, or NONE if empty
      */
-    Piece getPieceAt(Square square) const;
+    Piece getPieceAt(Square square) const { return board[square]; }
 
     /**
      * @brief Check whose turn it is to move
@@ -87,9 +91,46 @@ public:
      * @brief Make a move on the position
      * @param move The move to make
      * @return New position after the move
+     * 
+     * Copies the whole position; hot paths should use doMove/undoMove.
      */
     Position makeMove(const Move& move) const;
 
+    /**
+     * @brief Make a move in place
+     * @param move A legal move in this position
+     * 
+     * Pushes the state needed to take the move back onto the position's
+     * state stack. Room for 256 moves is reserved when the position is
+     * created or copied, so search does not allocate; longer games grow it.
+     */
+    void doMove(const Move& move);
+
+    /**
+     * @brief Take back the last move made with doMove
+     */
+    void undoMove();
+
+    /**
+     * @brief Pass the turn without moving (for null-move pruning)
+     * 
+     * Flips the side to move and clears the en passant square. Must not be
+     * used while in check; take it back with undoNullMove.
+     */
+    void doNullMove();
+
+    /**
+     * @brief Take back the last null move made with doNullMove
+     */
+    void undoNullMove();
+
+    /**
+     * @brief Check if a move would give check, without making it
+     * @param move A legal move in this position
+     * @return true if the opponent's king is attacked after the move
+     */
+    bool givesCheck(const Move& move) const;
+
     /**
      * @brief Check if the current side is in check
      * @return true if in check, false otherwise
@@ -104,6 +145,15 @@ public:
      */
     bool isSquareAttacked(Square square, Color byColor) const;
 
+    /**
+     * @brief Get every piece of either color attacking a square
+     * @param square The target square
+     * @param occupied Occupancy that blocks sliders; pass a board with
+     *        pieces removed to see x-ray attackers behind them
+     * @return Attackers of both colors (may include pieces not in occupied)
+     */
+    Bitboard attackersTo(Square square, Bitboard occupied) const;
+
     /**
      * @brief Convert position to FEN string
      * @return FEN representation of the position
@@ -116,6 +166,36 @@ public:
      */
     uint64_t getHash() const { return zobristHash; }
 
+    /**
+     * @brief Get the material balance (white minus black, kings excluded)
+     * 
+     * Kept up to date as pieces move, like the hash, so reading it is O(1).
+     */
+    int getMaterial() const { return material; }
+
+    /**
+     * @brief Get the piece-square score (white minus black) as a packed
+     * middlegame/endgame pair
+     */
+    Score getPsqt() const { return psqtScore; }
+
+    /**
+     * @brief Get the game phase: MAX_PHASE with all pieces on the board,
+     * falling towards 0 as knights, bishops, rooks and queens come off
+     * 
+     * Can exceed MAX_PHASE after promotions.
+     */
+    int getGamePhase() const { return gamePhase; }
+
+    /**
+     * @brief Recompute the Zobrist hash from scratch
+     * @return Hash of pieces, side to move, castling rights and en passant file
+     * 
+     * getHash() is maintained incrementally; this is the reference it is
+     * checked against in debug builds.
+     */
+    uint64_t computeHash() const;
+
     /**
      * @brief Check if position is a draw by repetition or 50-move rule
      * @return true if position is drawn
@@ -128,9 +208,65 @@ public:
     bool operator==(const Position& other) const;
 
 private:
+    // Everything doMove cannot recompute when taking a move back
+    struct StateInfo {
+        Move move;
+        Piece capturedPiece;
+        uint8_t castlingRights;
+        Square enPassantSquare;
+        int halfmoveClock;
+        uint64_t zobristHash;
+    };
+    
+    static constexpr size_t STATE_STACK_CAPACITY = 256;
+    
+    // Undo records, stored out of line so positions stay small. Room for
+    // STATE_STACK_CAPACITY moves is reserved up front, also in copies, so
+    // search never reallocates; longer games grow the storage instead of
+    // overflowing it.
+    class StateStack {
+    public:
+        StateStack() {
+            entries.reserve(STATE_STACK_CAPACITY);
+        }
+        
+        StateStack(const StateStack& other) {
+            entries.reserve(std::max(STATE_STACK_CAPACITY, other.entries.size()));
+            entries = other.entries;
+        }
+        
+        StateStack& operator=(const StateStack& other) {
+            entries.reserve(std::max(STATE_STACK_CAPACITY, other.entries.size()));
+            entries = other.entries;
+            return *this;
+        }
+        
+        StateStack(StateStack&&) = default;
+        StateStack& operator=(StateStack&&) = default;
+        
+        void push(const StateInfo& state) { entries.push_back(state); }
+        
+        void pop() {
+            assert(!entries.empty());
+            entries.pop_back();
+        }
+        
+        const StateInfo& back() const { return entries.back(); }
+        bool empty() const { return entries.empty(); }
+        void clear() { entries.clear(); }
+        
+    private:
+        std::vector<StateInfo> entries;
+    };
+    
     // Bitboards for each piece type and color
     std::array<std::array<Bitboard, 6>, 2> pieceBitboards;  // [color][piece_type]
     
+    // Redundant views kept in sync by putPiece/clearSquare for O(1) queries
+    std::array<Bitboard, 2> colorBitboards;  // [color]
+    Bitboard occupiedBitboard;
+    std::array<uint8_t, 64> board;           // Piece on each square, NO_PIECE if empty
+    
     // Game state
     Color sideToMove;
     uint8_t castlingRights;
@@ -141,9 +277,16 @@ private:
     // Zobrist hash for fast position comparison
     uint64_t zobristHash;
     
+    // Evaluation sums maintained by putPiece/clearSquare, white minus black
+    int material;
+    Score psqtScore;
+    int gamePhase;
+    
+    // Undo records for doMove/undoMove, most recent last
+    StateStack stateStack;
+    
     // Helper methods
     void initializeFromFEN(const std::string& fen);
-    void updateHash(const Move& move);
     void clearSquare(Square square);
     void putPiece(Square square, PieceType piece, Color color);
 };
@@ -0,0 +1,36 @@
+#pragma once
+
+#include "chess_analyzer/core/types.h"
+#include "chess_analyzer/core/move.h"
+#include "chess_analyzer/core/position.h"
+
+namespace chess {
+
+/**
+ * @brief Static exchange evaluation of a move
+ * @param position The position before the move
+ * @param move A legal move; non-captures are scored by whether the moved
+ *        piece can be won on its destination square
+ * @return Material the side to move gains (negative: loses) in centipawns
+ *         if both sides keep recapturing on the destination square with
+ *         their least valuable attacker while it pays off
+ * 
+ * Attackers hidden behind sliders (x-rays) join the exchange once the
+ * pieces in front of them have captured. Pins and checks are ignored, so
+ * this is an estimate that needs no search.
+ */
+int staticExchange(const Position& position, const Move& move);
+
+/**
+ * @brief Check if a move's static exchange wins at least a threshold
+ * @param position The position before the move
+ * @param move A legal move
+ * @param threshold Minimum gain in centipawns (0: does not lose material)
+ * @return true if staticExchange(position, move) >= threshold
+ * 
+ * Returns at once when the capture clearly wins, e.g. a pawn taking a piece,
+ * so it is cheaper than staticExchange in move ordering.
+ */
+bool staticExchangeAtLeast(const Position& position, const Move& move, int threshold);
+
+} // namespace chess
\ No newline at end of file
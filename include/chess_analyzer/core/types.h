@@ -20,6 +20,12 @@ using Piece = int;
 // Square constants
 constexpr Square NO_SQUARE = -1;
 constexpr Square A1 = 0, B1 = 1, C1 = 2, D1 = 3, E1 = 4, F1 = 5, G1 = 6, H1 = 7;
+constexpr Square A2 = 8, B2 = 9, C2 = 10, D2 = 11, E2 = 12, F2 = 13, G2 = 14, H2 = 15;
+constexpr Square A3 = 16, B3 = 17, C3 = 18, D3 = 19, E3 = 20, F3 = 21, G3 = 22, H3 = 23;
+constexpr Square A4 = 24, B4 = 25, C4 = 26, D4 = 27, E4 = 28, F4 = 29, G4 = 30, H4 = 31;
+constexpr Square A5 = 32, B5 = 33, C5 = 34, D5 = 35, E5 = 36, F5 = 37, G5 = 38, H5 = 39;
+constexpr Square A6 = 40, B6 = 41, C6 = 42, D6 = 43, E6 = 44, F6 = 45, G6 = 46, H6 = 47;
+constexpr Square A7 = 48, B7 = 49, C7 = 50, D7 = 51, E7 = 52, F7 = 53, G7 = 54, H7 = 55;
 constexpr Square A8 = 56, B8 = 57, C8 = 58, D8 = 59, E8 = 60, F8 = 61, G8 = 62, H8 = 63;
 
 // Colors
@@ -73,6 +79,13 @@ enum PromotionType : uint8_t {
     PROMOTE_TO_KNIGHT = 3
 };
 
+// Middlegame and endgame values packed into one integer, the endgame value
+// in the upper 16 bits, so both phases are added with a single integer add.
+// Each half must stay within 16 bits.
+enum Score : int32_t {
+    SCORE_ZERO = 0
+};
+
 // Direction offsets for move generation
 namespace Direction {
     constexpr int NORTH = 8;
@@ -86,6 +99,27 @@ namespace Direction {
 }
 
 // Utility functions
+constexpr Score makeScore(int mg, int eg) {
+    return static_cast<Score>(static_cast<int32_t>(static_cast<uint32_t>(eg) << 16) + mg);
+}
+
+inline int mgValue(Score s) {
+    return static_cast<int16_t>(static_cast<uint16_t>(static_cast<uint32_t>(s)));
+}
+
+// A negative middlegame half borrows one from the endgame half; adding
+// 0x8000 before shifting gives it back
+inline int egValue(Score s) {
+    return static_cast<int16_t>(static_cast<uint16_t>(static_cast<uint32_t>(s + 0x8000) >> 16));
+}
+
+constexpr Score operator+(Score a, Score b) { return static_cast<Score>(int32_t(a) + int32_t(b)); }
+constexpr Score operator-(Score a, Score b) { return static_cast<Score>(int32_t(a) - int32_t(b)); }
+constexpr Score operator-(Score s) { return static_cast<Score>(-int32_t(s)); }
+constexpr Score operator*(Score s, int i) { return static_cast<Score>(int32_t(s) * i); }
+inline Score& operator+=(Score& a, Score b) { return a = a + b; }
+inline Score& operator-=(Score& a, Score b) { return a = a - b; }
+
 inline Color operator~(Color c) {
     return static_cast<Color>(c ^ 1);
 }
@@ -151,7 +185,7 @@ inline int popcount(Bitboard b) {
 
 // Piece utilities
 inline PieceType typeOf(Piece p) {
-    return static_cast<PieceType>((p - 1) % 6);
+    return static_cast<PieceType>((p & 7) - 1);
 }
 
 inline Color colorOf(Piece p) {
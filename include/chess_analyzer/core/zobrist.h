@@ -0,0 +1,25 @@
+#pragma once
+
+#include "chess_analyzer/core/types.h"
+
+namespace chess {
+
+/**
+ * @brief Random keys for Zobrist hashing of positions
+ * 
+ * A position's hash is the XOR of the keys of every piece on its square,
+ * the side-to-move key when black is to move, the castling key for the
+ * current rights and the en passant file key when an en passant square is set.
+ * Keys are generated at compile time from a fixed seed, so hashes are
+ * stable across runs and builds.
+ */
+struct ZobristKeys {
+    uint64_t pieceSquare[2][6][64];  // [color][piece_type][square]
+    uint64_t sideToMove;
+    uint64_t castling[16];           // Indexed by the full castling rights bitfield
+    uint64_t enPassantFile[8];
+};
+
+extern const ZobristKeys zobrist;
+
+} // namespace chess
\ No newline at end of file
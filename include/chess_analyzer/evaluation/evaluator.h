@@ -2,6 +2,7 @@
 
 #include "chess_analyzer/core/types.h"
 #include "chess_analyzer/core/position.h"
+#include "chess_analyzer/core/piece_square_tables.h"
 #include <memory>
 
 namespace chess {
@@ -79,14 +80,4 @@ private:
     std::unique_ptr<Impl> pImpl;
 };
 
-// Piece values in centipawns
-namespace PieceValue {
-    constexpr int PAWN = 100;
-    constexpr int KNIGHT = 320;
-    constexpr int BISHOP = 330;
-    constexpr int ROOK = 500;
-    constexpr int QUEEN = 900;
-    constexpr int KING = 20000;
-}
-
 } // namespace chess 
\ No newline at end of file
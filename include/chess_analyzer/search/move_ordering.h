@@ -0,0 +1,93 @@
+#pragma once
+
+#include "chess_analyzer/core/types.h"
+#include "chess_analyzer/core/move.h"
+#include "chess_analyzer/core/move_list.h"
+#include "chess_analyzer/core/position.h"
+#include "chess_analyzer/search/searcher.h"
+
+namespace chess {
+
+// Move ordering scores: hash move, then captures that don't lose material
+// by MVV-LVA, then the two killers, then quiet moves by history, and
+// captures that lose material last
+constexpr int HASH_MOVE_SCORE = 1 << 30;
+constexpr int CAPTURE_SCORE = 1 << 29;
+constexpr int KILLER_SCORE = 1 << 28;
+constexpr int LOSING_CAPTURE_SCORE = -(1 << 28);
+
+// History counters are halved once one of them reaches this value so
+// recent cutoffs outweigh old ones and quiets never outrank killers
+constexpr int HISTORY_MAX = 1 << 20;
+
+/**
+ * @brief Material a capture or promotion wins outright, in centipawns
+ */
+int captureGain(const Position& position, const Move& move);
+
+/**
+ * @brief Capture ordering key: most valuable victim first, least valuable
+ * attacker breaking ties
+ */
+int mvvLva(const Position& position, const Move& move);
+
+/**
+ * @brief Check if a move is ordered by material (captures and queen
+ * promotions) rather than by killers and history
+ */
+bool isTactical(const Position& position, const Move& move);
+
+/**
+ * @brief Killer moves and butterfly history for one searcher
+ *
+ * Quiet moves that caused a beta cutoff are remembered per ply (the two
+ * most recent, as killers) and credited by side, from and to square (as
+ * history), so sibling nodes try them early. One instance belongs to one
+ * searcher and is not shared between threads.
+ */
+class MoveOrdering {
+public:
+    MoveOrdering();
+
+    /**
+     * @brief Forget all killers and history, e.g. at the start of a search
+     */
+    void clear();
+
+    /**
+     * @brief Give every move an ordering score; higher is searched first
+     * @param position The position the moves belong to
+     * @param moves Moves to score; scores are written with MoveList::score
+     * @param hashMove Best move stored in the transposition table, or NULL_MOVE
+     * @param ply Distance from the root, selecting the killers
+     */
+    void scoreMoves(const Position& position, MoveList& moves, Move hashMove, int ply) const;
+
+    /**
+     * @brief Record a quiet move that caused a beta cutoff
+     * @param position The position the move was played from
+     * @param move The quiet move
+     * @param depth Remaining depth of the node; deeper cutoffs earn more history
+     * @param ply Distance from the root
+     */
+    void updateQuietStats(const Position& position, Move move, int depth, int ply);
+
+    /**
+     * @brief Killer move of a ply, slot 0 being the most recent (NULL_MOVE if none)
+     */
+    Move killer(int ply, int slot) const { return killers[ply][slot]; }
+
+    /**
+     * @brief History score of a quiet move for one side
+     */
+    int historyScore(Color side, Move move) const { return history[side][move.from()][move.to()]; }
+
+private:
+    // Quiet moves that caused a beta cutoff at each ply, most recent first
+    Move killers[MAX_PLY + 1][2];
+
+    // Butterfly history: cutoff credit for quiet moves by side, from and to
+    int history[2][64][64];
+};
+
+} // namespace chess
\ No newline at end of file
@@ -0,0 +1,98 @@
+#pragma once
+
+#include "chess_analyzer/search/searcher.h"
+#include <atomic>
+#include <functional>
+#include <future>
+#include <memory>
+#include <thread>
+
+namespace chess {
+
+/**
+ * @brief A search running on its own thread
+ *
+ * Returned by ChessAnalyzer::startSearch. The caller polls progress(),
+ * stops the search when its result is no longer wanted, and collects the
+ * final result with wait() or through future(). Destroying the handle stops
+ * the search and waits for its thread, so an abandoned request never keeps
+ * searching. Handles are movable but not copyable; all methods except
+ * assignment may be called from any thread.
+ */
+class SearchHandle {
+public:
+    /**
+     * @brief The work a handle runs: searches until the stop flag is raised
+     * or its limits are reached, reporting each completed iteration
+     */
+    using Job = std::function<SearchResult(const std::atomic<bool>& stop,
+                                           const SearchProgressCallback& progress)>;
+
+    /**
+     * @brief Create an empty handle that owns no search
+     */
+    SearchHandle();
+    ~SearchHandle();
+
+    SearchHandle(SearchHandle&& other) noexcept;
+    SearchHandle& operator=(SearchHandle&& other) noexcept;
+    SearchHandle(const SearchHandle&) = delete;
+    SearchHandle& operator=(const SearchHandle&) = delete;
+
+    /**
+     * @brief Start a job on a new thread
+     * @param job The search to run
+     * @return Handle owning the running search
+     */
+    static SearchHandle launch(Job job);
+
+    /**
+     * @brief Check if the handle owns a search (running or finished)
+     */
+    bool valid() const { return state != nullptr; }
+
+    /**
+     * @brief Latest completed iteration: depth, score, PV, nodes and time
+     * @return Empty result (depth 0) until the first iteration completes or
+     *         if the handle is empty, the final result once the search has
+     *         finished
+     */
+    SearchResult progress() const;
+
+    /**
+     * @brief Ask the search to stop; returns at once
+     *
+     * The search finishes with the result of its last completed iteration.
+     */
+    void stop();
+
+    /**
+     * @brief Check if the search has finished and its result is ready
+     */
+    bool isFinished() const;
+
+    /**
+     * @brief Block until the search finishes
+     * @return The final search result (empty if the handle is empty)
+     */
+    SearchResult wait() const;
+
+    /**
+     * @brief Future for the final result, for use with other waiting code
+     * (invalid if the handle is empty)
+     *
+     * It stays valid after the handle is destroyed; the search is stopped
+     * at that point, so the future then holds its last completed iteration.
+     */
+    std::shared_future<SearchResult> future() const;
+
+private:
+    struct State;
+
+    std::shared_ptr<State> state;
+    std::thread worker;
+
+    void finish();
+};
+
+} // namespace chess
\ No newline at end of file
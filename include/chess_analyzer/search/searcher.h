@@ -0,0 +1,198 @@
+#pragma once
+
+#include "chess_analyzer/core/types.h"
+#include "chess_analyzer/core/position.h"
+#include "chess_analyzer/core/move.h"
+#include "chess_analyzer/evaluation/evaluator.h"
+#include "chess_analyzer/search/transposition_table.h"
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace chess {
+
+// Search score bounds; mate scores count plies from the root
+constexpr int MAX_PLY = 128;
+constexpr int INFINITE_SCORE = 32000;
+constexpr int MATE_SCORE = 30000;
+constexpr int MATE_IN_MAX_PLY = MATE_SCORE - MAX_PLY;
+
+/**
+ * @brief Check if a score announces a forced mate for either side
+ */
+inline bool isMateScore(int score) {
+    return score >= MATE_IN_MAX_PLY || score <= -MATE_IN_MAX_PLY;
+}
+
+/**
+ * @brief Limits for one search; a zero field means no limit of that kind
+ */
+struct SearchLimits {
+    int depth = 0;        // Maximum iteration depth in plies
+    int64_t timeMs = 0;   // Wall-clock budget in milliseconds
+    uint64_t nodes = 0;   // Node budget
+    int multiPV = 1;      // Number of best root moves to rank (MultiPV)
+};
+
+/**
+ * @brief One ranked root move of a MultiPV search
+ */
+struct PVLine {
+    Move move;              // Root move this line starts with
+    int score = 0;          // Centipawns from the side to move's point of view
+    std::vector<Move> pv;   // Principal variation, starting with move
+};
+
+/**
+ * @brief Pruning and reduction settings, so each technique can be tuned or
+ * switched off for comparison
+ */
+struct SearchOptions {
+    bool aspirationWindows = true;  // Search the root in a window around the last score
+    int aspirationDelta = 25;       // Initial half-width; doubles on every fail
+    
+    bool nullMove = true;          // Null-move pruning
+    int nullMoveMinDepth = 3;      // Shallowest depth at which a null move is tried
+    int nullMoveReduction = 2;     // Base reduction R; grows by one every 6 plies of depth
+    
+    bool lateMoveReductions = true;  // Reduce late quiet moves, re-searching on fail-high
+    int lmrMinDepth = 3;             // Shallowest depth at which moves are reduced
+    int lmrFullDepthMoves = 3;       // Moves searched at full depth before reducing
+    double lmrBase = 0.75;           // Reduction is lmrBase + ln(depth) * ln(moveNumber) / lmrDivisor
+    double lmrDivisor = 2.25;
+};
+
+/**
+ * @brief Work done by one completed iteration of iterative deepening
+ */
+struct IterationStats {
+    int depth = 0;
+    uint64_t nodes = 0;    // Nodes searched during this iteration
+    int64_t timeMs = 0;    // Time spent on this iteration
+};
+
+/**
+ * @brief Counters describing where a search spent its nodes
+ *
+ * Every searcher counts into its own copy, so threads never contend on
+ * them; a multithreaded search adds the helpers' counters to the main
+ * thread's when it finishes.
+ */
+struct SearchStats {
+    uint64_t nodes = 0;             // All nodes, quiescence included
+    uint64_t qnodes = 0;            // Quiescence nodes
+    uint64_t ttProbes = 0;          // Transposition table lookups
+    uint64_t ttHits = 0;            // Lookups that found the position
+    uint64_t ttCutoffs = 0;         // Nodes answered from the table alone
+    uint64_t betaCutoffs = 0;       // Nodes that failed high
+    uint64_t firstMoveCutoffs = 0;  // ... on the first move searched
+    uint64_t aspirationResearches = 0;  // Root searches repeated after leaving the window
+    int64_t timeMs = 0;             // Wall-clock time of the main thread
+    std::vector<IterationStats> iterations;  // Main thread's completed iterations
+
+    /**
+     * @brief Nodes per second over the whole search (0 if it took no measurable time)
+     */
+    uint64_t nodesPerSecond() const;
+
+    /**
+     * @brief Fraction of fail-high nodes where the first move already cut off
+     *
+     * Close to 1 means move ordering rarely makes the search look past the
+     * first move.
+     */
+    double firstMoveCutoffRate() const;
+
+    /**
+     * @brief Effective branching factor: growth in nodes per extra ply
+     * across the completed iterations (0 with fewer than two)
+     */
+    double branchingFactor() const;
+
+    /**
+     * @brief Add another thread's counters; iterations are kept as they are
+     */
+    SearchStats& operator+=(const SearchStats& other);
+};
+
+/**
+ * @brief Outcome of a search, taken from the last completed iteration
+ */
+struct SearchResult {
+    Move bestMove;          // NULL_MOVE only if the position has no legal moves
+    int score = 0;          // Centipawns from the side to move's point of view
+    int depth = 0;          // Depth of the last completed iteration
+    std::vector<Move> pv;   // Principal variation, starting with bestMove
+    uint64_t nodes = 0;     // Nodes searched, including unfinished iterations
+    int64_t timeMs = 0;     // Wall-clock time used
+    std::vector<PVLine> lines;  // Best root moves, best first; lines[0] matches bestMove
+    SearchStats stats;          // Counters for tuning; ignore unless needed
+};
+
+/**
+ * @brief Called by a searcher after each completed iteration with the
+ * result so far; runs on the searching thread
+ */
+using SearchProgressCallback = std::function<void(const SearchResult&)>;
+
+/**
+ * @brief Iterative-deepening alpha-beta searcher
+ *
+ * Searches depth 1, 2, 3, ... until a limit is reached or the stop flag is
+ * raised, and reports the result of the last iteration that completed. A
+ * searcher keeps per-search state and must be used by one thread at a time;
+ * several searchers can share one transposition table and evaluator.
+ *
+ * For Lazy SMP, helper searchers (threadIndex > 0) run alongside the main
+ * one on the same table and skip some iterations, so the threads are spread
+ * over neighbouring depths and fill the table with each other's results.
+ */
+class Searcher {
+public:
+    /**
+     * @param evaluator Static evaluation used at the leaves
+     * @param tt Transposition table, possibly shared with other searchers
+     * @param threadIndex 0 for the main searcher, 1.. for Lazy SMP helpers
+     */
+    Searcher(const Evaluator& evaluator, TranspositionTable& tt, int threadIndex = 0);
+    ~Searcher();
+
+    /**
+     * @brief Replace the pruning and reduction settings (defaults: SearchOptions{})
+     */
+    void setOptions(const SearchOptions& options);
+
+    /**
+     * @brief Report every completed iteration to a callback (none by default)
+     */
+    void setProgressCallback(SearchProgressCallback callback);
+
+    /**
+     * @brief Add this searcher's nodes to a counter shared with other
+     * searchers, and apply the node limit to the shared total
+     * @param counter Counter that outlives the search; nullptr (the
+     *        default) counts this searcher alone
+     * 
+     * Nodes are added every few thousand nodes, so a search can overrun
+     * its limit by that much per thread.
+     */
+    void setNodeCounter(std::atomic<uint64_t>* counter);
+
+    /**
+     * @brief Search a position
+     * @param position The position to search
+     * @param limits Depth, time and node limits
+     * @param stop Raised by another thread to end the search early
+     * @return Best move, score and PV of the last completed iteration
+     */
+    SearchResult search(const Position& position, const SearchLimits& limits,
+                        const std::atomic<bool>& stop);
+
+private:
+    class Impl;
+    std::unique_ptr<Impl> pImpl;
+};
+
+} // namespace chess
\ No newline at end of file
@@ -0,0 +1,116 @@
+#pragma once
+
+#include "chess_analyzer/core/types.h"
+#include "chess_analyzer/core/move.h"
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+namespace chess {
+
+/**
+ * @brief How a stored score relates to the true score of a position
+ */
+enum Bound : uint8_t {
+    BOUND_NONE = 0,
+    BOUND_UPPER = 1,  // Failed low: true score <= stored score
+    BOUND_LOWER = 2,  // Failed high: true score >= stored score
+    BOUND_EXACT = BOUND_UPPER | BOUND_LOWER
+};
+
+/**
+ * @brief Decoded contents of a transposition table entry
+ */
+struct TTEntry {
+    Move move;
+    int score;
+    int depth;
+    Bound bound;
+};
+
+/**
+ * @brief Shared hash table of search results, safe for concurrent use without locks
+ * 
+ * Entries are grouped in cache-line-sized buckets of four, so a probe
+ * touches a single line. Each entry is two 64-bit words, the key XORed with
+ * the data and the data itself; a torn write from another thread fails the
+ * check on read and is treated as a miss. Replacement prefers shallow
+ * entries and entries left over from earlier searches.
+ * 
+ * probe(), store() and newSearch() may be called from any number of threads;
+ * resize() and clear() need exclusive access.
+ */
+class TranspositionTable {
+public:
+    /**
+     * @brief Create a table of at most the given size
+     * @param megabytes Table size; rounded down to a power of two number of buckets
+     */
+    explicit TranspositionTable(size_t megabytes = 16);
+
+    /**
+     * @brief Reallocate the table, discarding all entries
+     * @param megabytes New table size
+     */
+    void resize(size_t megabytes);
+
+    /**
+     * @brief Remove all entries
+     */
+    void clear();
+
+    /**
+     * @brief Start a new search; older entries become preferred for replacement
+     */
+    void newSearch() {
+        generation.store((generation.load(std::memory_order_relaxed) + 1) & GENERATION_MASK,
+                         std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Look up a position
+     * @param key Zobrist hash of the position
+     * @param entry Filled in on a hit
+     * @return true if the position was found
+     */
+    bool probe(uint64_t key, TTEntry& entry) const;
+
+    /**
+     * @brief Store a search result
+     * @param key Zobrist hash of the position
+     * @param depth Remaining depth the score was searched to
+     * @param score Score, with mate scores relative to this position
+     * @param bound Whether the score is exact or a bound
+     * @param move Best move found, or NULL_MOVE to keep the stored one
+     */
+    void store(uint64_t key, int depth, int score, Bound bound, Move move);
+
+    /**
+     * @brief Permille of sampled entries written during the current search
+     */
+    int hashfull() const;
+
+    /**
+     * @brief Size of the table in bytes
+     */
+    size_t sizeInBytes() const { return buckets.size() * sizeof(Bucket); }
+
+private:
+    static constexpr int ENTRIES_PER_BUCKET = 4;
+    static constexpr uint8_t GENERATION_MASK = 0x3F;
+
+    struct Entry {
+        std::atomic<uint64_t> check{0};  // key ^ data
+        std::atomic<uint64_t> data{0};
+    };
+
+    struct alignas(64) Bucket {
+        Entry entries[ENTRIES_PER_BUCKET];
+    };
+
+    std::vector<Bucket> buckets;
+    size_t mask;
+    std::atomic<uint8_t> generation;
+};
+
+} // namespace chess
\ No newline at end of file
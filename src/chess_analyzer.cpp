@@ -3,68 +3,88 @@
 #include "chess_analyzer/evaluation/evaluator.h"
 #include "chess_analyzer/explanation/move_explainer.h"
 #include "chess_analyzer/notation/pgn_parser.h"
+#include "chess_analyzer/search/searcher.h"
+#include "chess_analyzer/search/transposition_table.h"
 #include <algorithm>
-#include <limits>
+#include <atomic>
+#include <mutex>
+#include <shared_mutex>
+#include <thread>
+#include <vector>
 
 namespace chess {
 
 class ChessAnalyzer::Impl {
 public:
-    Impl() : moveGen(), evaluator(), explainer(), pgnParser() {}
+    Impl() : moveGen(), evaluator(), explainer(), pgnParser(), tt(), stopRequested(false) {}
     
     MoveGenerator moveGen;
     Evaluator evaluator;
     MoveExplainer explainer;
     PGNParser pgnParser;
+    TranspositionTable tt;
+    std::atomic<bool> stopRequested;
     
-    // Simple minimax search for finding best move
-    struct SearchResult {
-        Move move;
-        int score;
-    };
+    // Settings for new searches; guarded so they can be changed while other
+    // threads start searches. Each search takes a copy when it starts.
+    std::mutex settingsMutex;
+    int threads = 1;
+    SearchOptions searchOptions;
     
-    SearchResult search(const Position& pos, int depth, int alpha, int beta) {
-        if (depth == 0) {
-            return {NULL_MOVE, evaluator.evaluate(pos)};
-        }
+    // Held shared by every running search and exclusively by setHashSize and
+    // clearHash, so the table is never resized or wiped under a search
+    std::shared_mutex tableMutex;
+    
+    void copySettings(int& threadCount, SearchOptions& options) {
+        std::lock_guard<std::mutex> lock(settingsMutex);
+        threadCount = threads;
+        options = searchOptions;
+    }
+    
+    SearchResult runSearch(const Position& position, const SearchLimits& limits, int threads,
+                           const SearchOptions& options, const std::atomic<bool>& stop,
+                           const SearchProgressCallback& progress) {
+        std::shared_lock<std::shared_mutex> tableLock(tableMutex);
+        tt.newSearch();
         
-        std::vector<Move> moves = moveGen.generateLegalMoves(pos);
+        // Lazy SMP: helpers search the same position and are stopped as soon
+        // as the main thread finishes. All threads add their nodes to one
+        // counter and each stops once the total reaches the node limit.
+        std::atomic<bool> helpersStop(false);
+        std::atomic<uint64_t> sharedNodes(0);
+        SearchLimits helperLimits;
+        helperLimits.depth = limits.depth;
+        helperLimits.nodes = limits.nodes;
         
-        if (moves.empty()) {
-            // No legal moves - checkmate or stalemate
-            if (pos.isInCheck()) {
-                return {NULL_MOVE, -20000 + depth};  // Checkmate (prefer faster mates)
-            } else {
-                return {NULL_MOVE, 0};  // Stalemate
-            }
+        std::vector<std::thread> helpers;
+        std::vector<SearchStats> helperStats(threads - 1);
+        for (int i = 1; i < threads; ++i) {
+            helpers.emplace_back([this, &position, &helperLimits, &options, &helpersStop,
+                                  &sharedNodes, &helperStats, i] {
+                Searcher helper(evaluator, tt, i);
+                helper.setOptions(options);
+                helper.setNodeCounter(&sharedNodes);
+                helperStats[i - 1] = helper.search(position, helperLimits, helpersStop).stats;
+            });
         }
         
-        SearchResult best = {moves[0], -std::numeric_limits<int>::max()};
-        
-        // Order moves for better pruning (captures first)
-        std::sort(moves.begin(), moves.end(), [&pos](const Move& a, const Move& b) {
-            bool aCapture = pos.getPieceAt(a.to()) != NO_PIECE;
-            bool bCapture = pos.getPieceAt(b.to()) != NO_PIECE;
-            return aCapture > bCapture;
-        });
-        
-        for (const Move& move : moves) {
-            Position newPos = pos.makeMove(move);
-            SearchResult result = search(newPos, depth - 1, -beta, -alpha);
-            result.score = -result.score;
-            
-            if (result.score > best.score) {
-                best.move = move;
-                best.score = result.score;
-            }
-            
-            alpha = std::max(alpha, result.score);
-            if (alpha >= beta) {
-                break;  // Beta cutoff
-            }
+        Searcher searcher(evaluator, tt);
+        searcher.setOptions(options);
+        searcher.setProgressCallback(progress);
+        if (threads > 1) {
+            searcher.setNodeCounter(&sharedNodes);
         }
+        SearchResult result = searcher.search(position, limits, stop);
         
-        return best;
+        helpersStop = true;
+        for (std::thread& helper : helpers) {
+            helper.join();
+        }
+        for (const SearchStats& stats : helperStats) {
+            result.stats += stats;
+        }
+        result.nodes = result.stats.nodes;
+        return result;
     }
 };
 
@@ -84,10 +104,69 @@ std::string ChessAnalyzer::explainMove(const Position& position, const Move& mov
 }
 
 Move ChessAnalyzer::findBestMove(const Position& position, int depth) const {
-    auto result = pImpl->search(position, depth, 
-                               -std::numeric_limits<int>::max(), 
-                               std::numeric_limits<int>::max());
-    return result.move;
+    SearchLimits limits;
+    limits.depth = depth;
+    return search(position, limits).bestMove;
+}
+
+std::vector<PVLine> ChessAnalyzer::findTopMoves(const Position& position, int count, int depth) const {
+    SearchLimits limits;
+    limits.depth = depth;
+    limits.multiPV = count;
+    return search(position, limits).lines;
+}
+
+SearchResult ChessAnalyzer::search(const Position& position, const SearchLimits& limits) const {
+    int threads;
+    SearchOptions options;
+    pImpl->copySettings(threads, options);
+    pImpl->stopRequested = false;
+    return pImpl->runSearch(position, limits, threads, options, pImpl->stopRequested, nullptr);
+}
+
+SearchHandle ChessAnalyzer::startSearch(const Position& position, const SearchLimits& limits) const {
+    Impl* impl = pImpl.get();
+    int threads;
+    SearchOptions options;
+    impl->copySettings(threads, options);
+    return SearchHandle::launch([impl, position, limits, threads, options](
+                                    const std::atomic<bool>& stop, const SearchProgressCallback& progress) {
+        return impl->runSearch(position, limits, threads, options, stop, progress);
+    });
+}
+
+void ChessAnalyzer::stopSearch() const {
+    pImpl->stopRequested = true;
+}
+
+void ChessAnalyzer::setHashSize(size_t megabytes) {
+    std::unique_lock<std::shared_mutex> tableLock(pImpl->tableMutex);
+    pImpl->tt.resize(megabytes);
+}
+
+void ChessAnalyzer::clearHash() {
+    std::unique_lock<std::shared_mutex> tableLock(pImpl->tableMutex);
+    pImpl->tt.clear();
+}
+
+void ChessAnalyzer::setThreads(int count) {
+    std::lock_guard<std::mutex> lock(pImpl->settingsMutex);
+    pImpl->threads = std::max(count, 1);
+}
+
+int ChessAnalyzer::getThreads() const {
+    std::lock_guard<std::mutex> lock(pImpl->settingsMutex);
+    return pImpl->threads;
+}
+
+void ChessAnalyzer::setSearchOptions(const SearchOptions& options) {
+    std::lock_guard<std::mutex> lock(pImpl->settingsMutex);
+    pImpl->searchOptions = options;
+}
+
+SearchOptions ChessAnalyzer::getSearchOptions() const {
+    std::lock_guard<std::mutex> lock(pImpl->settingsMutex);
+    return pImpl->searchOptions;
 }
 
 std::vector<std::string> ChessAnalyzer::analyzeGame(const std::string& pgn) const {
@@ -102,7 +181,7 @@ std::vector<std::string> ChessAnalyzer::analyzeGame(const std::string& pgn) cons
         for (const Move& move : game.moves) {
             std::string explanation = explainMove(pos, move);
             analysis.push_back(explanation);
-            pos = pos.makeMove(move);
+            pos.doMove(move);
         }
     } catch (const std::exception& e) {
         analysis.push_back("Error parsing game: " + std::string(e.what()));
@@ -1,5 +1,10 @@
 #include "chess_analyzer/core/bitboard_attacks.h"
 #include <array>
+#include <cstdlib>
+
+#if CHESS_HAS_PEXT && !defined(_MSC_VER)
+#include <cpuid.h>
+#endif
 
 namespace chess {
 
@@ -9,11 +14,138 @@ namespace {
     std::array<Bitboard, 64> kingAttacks;
     std::array<std::array<Bitboard, 64>, 2> pawnAttacks;
     
+    // Shared attack tables indexed through MagicEntry::attacks
+    Bitboard rookTable[0x19000];   // Sum of 2^bits over all rook masks
+    Bitboard bishopTable[0x1480];  // Sum of 2^bits over all bishop masks
+    
+    // Classical ray walk, only used to fill the magic tables
+    Bitboard slidingAttacks(PieceType pt, Square sq, Bitboard occupied) {
+        static const int rookDirs[4][2] = {{1, 0}, {-1, 0}, {0, 1}, {0, -1}};
+        static const int bishopDirs[4][2] = {{1, 1}, {1, -1}, {-1, 1}, {-1, -1}};
+        const int (*dirs)[2] = (pt == ROOK) ? rookDirs : bishopDirs;
+        
+        Bitboard attacks = 0;
+        for (int d = 0; d < 4; ++d) {
+            int r = rankOf(sq) + dirs[d][0];
+            int f = fileOf(sq) + dirs[d][1];
+            while (r >= 0 && r < 8 && f >= 0 && f < 8) {
+                Square s = makeSquare(f, r);
+                attacks |= squareBB(s);
+                if (occupied & squareBB(s)) break;
+                r += dirs[d][0];
+                f += dirs[d][1];
+            }
+        }
+        return attacks;
+    }
+    
+    // xorshift64* generator used for the magic number search
+    class MagicPRNG {
+    public:
+        explicit MagicPRNG(uint64_t seed) : s(seed) {}
+        
+        uint64_t rand() {
+            s ^= s >> 12;
+            s ^= s << 25;
+            s ^= s >> 27;
+            return s * 2685821657736338717ULL;
+        }
+        
+        // Magics with few set bits are found much faster
+        uint64_t sparseRand() {
+            return rand() & rand() & rand();
+        }
+        
+    private:
+        uint64_t s;
+    };
+    
+    // Find a magic for every square and fill the shared attack table.
+    // Seeds are fixed per rank so startup is deterministic and fast.
+    void initMagics(PieceType pt, Bitboard table[], MagicEntry magics[]) {
+        static const uint64_t seeds[8] = {728, 10316, 55013, 32803, 12281, 15100, 16645, 255};
+        
+        Bitboard occupancy[4096];
+        Bitboard reference[4096];
+        int epoch[4096] = {};
+        int attempt = 0;
+        
+        for (Square sq = A1; sq <= H8; ++sq) {
+            MagicEntry& m = magics[sq];
+            
+            // Board edges are never relevant blockers unless the slider sits on them
+            Bitboard edges = ((RANK_1 | RANK_8) & ~(RANK_1 << (8 * rankOf(sq)))) |
+                             ((FILE_A | FILE_H) & ~(FILE_A << fileOf(sq)));
+            m.mask = slidingAttacks(pt, sq, 0) & ~edges;
+            m.shift = 64 - popcount(m.mask);
+            m.attacks = (sq == A1) ? table : magics[sq - 1].attacks + (1ULL << (64 - magics[sq - 1].shift));
+            
+            // Enumerate all subsets of the mask (Carry-Rippler)
+            int size = 0;
+            Bitboard b = 0;
+            do {
+                occupancy[size] = b;
+                reference[size] = slidingAttacks(pt, sq, b);
+                size++;
+                b = (b - m.mask) & m.mask;
+            } while (b);
+            
+            MagicPRNG rng(seeds[rankOf(sq)]);
+            
+            for (int i = 0; i < size; ) {
+                for (m.magic = 0; popcount((m.magic * m.mask) >> 56) < 6; ) {
+                    m.magic = rng.sparseRand();
+                }
+                
+                // Epoch stamps avoid clearing the table between attempts
+                ++attempt;
+                for (i = 0; i < size; ++i) {
+                    unsigned idx = unsigned(((occupancy[i] & m.mask) * m.magic) >> m.shift);
+                    if (epoch[idx] < attempt) {
+                        epoch[idx] = attempt;
+                        m.attacks[idx] = reference[i];
+                    } else if (m.attacks[idx] != reference[i]) {
+                        break;
+                    }
+                }
+            }
+        }
+    }
+    
+    // Rewrite every square's attack slice in the order of the active backend
+    void fillTables(PieceType pt, MagicEntry magics[]) {
+        for (Square sq = A1; sq <= H8; ++sq) {
+            const MagicEntry& m = magics[sq];
+            Bitboard b = 0;
+            do {
+                m.attacks[m.index(b)] = slidingAttacks(pt, sq, b);
+                b = (b - m.mask) & m.mask;
+            } while (b);
+        }
+    }
+    
+    void cpuid(unsigned leaf, unsigned subleaf, unsigned regs[4]) {
+#if !CHESS_HAS_PEXT
+        (void)leaf;
+        (void)subleaf;
+        regs[0] = regs[1] = regs[2] = regs[3] = 0;
+#elif defined(_MSC_VER)
+        int info[4];
+        __cpuidex(info, static_cast<int>(leaf), static_cast<int>(subleaf));
+        for (int i = 0; i < 4; ++i) regs[i] = static_cast<unsigned>(info[i]);
+#else
+        regs[0] = regs[1] = regs[2] = regs[3] = 0;
+        __get_cpuid_count(leaf, subleaf, &regs[0], &regs[1], &regs[2], &regs[3]);
+#endif
+    }
+    
     struct AttackTableInit {
         AttackTableInit() {
             initKnightAttacks();
             initKingAttacks();
             initPawnAttacks();
+            initializeMagicBitboards();
+            initLineTables();
         }
         
         void initKnightAttacks() {
@@ -63,6 +195,25 @@ namespace {
             }
         }
         
+        void initLineTables() {
+            for (Square a = A1; a <= H8; ++a) {
+                for (Square b = A1; b <= H8; ++b) {
+                    betweenTable[a][b] = 0;
+                    lineTable[a][b] = 0;
+                    if (a == b) continue;
+                    
+                    for (PieceType pt : {BISHOP, ROOK}) {
+                        if (slidingAttacks(pt, a, 0) & squareBB(b)) {
+                            lineTable[a][b] = (slidingAttacks(pt, a, 0) & slidingAttacks(pt, b, 0)) |
+                                              squareBB(a) | squareBB(b);
+                            betweenTable[a][b] = slidingAttacks(pt, a, squareBB(b)) &
+                                                 slidingAttacks(pt, b, squareBB(a));
+                        }
+                    }
+                }
+            }
+        }
+        
         void initPawnAttacks() {
             for (Square sq = A1; sq <= H8; ++sq) {
                 int rank = rankOf(sq);
@@ -96,84 +247,12 @@ Bitboard pawnAttacksBB(Bitboard pawns, Color c) {
     }
 }
 
-Bitboard knightAttacksBB(Square sq) {
-    return knightAttacks[sq];
-}
-
-Bitboard bishopAttacksBB(Square sq, Bitboard occupied) {
-    Bitboard attacks = 0;
-    int rank = rankOf(sq);
-    int file = fileOf(sq);
-    
-    // Northeast
-    for (int r = rank + 1, f = file + 1; r < 8 && f < 8; ++r, ++f) {
-        Square s = makeSquare(f, r);
-        attacks |= squareBB(s);
-        if (occupied & squareBB(s)) break;
-    }
-    
-    // Southeast
-    for (int r = rank - 1, f = file + 1; r >= 0 && f < 8; --r, ++f) {
-        Square s = makeSquare(f, r);
-        attacks |= squareBB(s);
-        if (occupied & squareBB(s)) break;
-    }
-    
-    // Southwest
-    for (int r = rank - 1, f = file - 1; r >= 0 && f >= 0; --r, --f) {
-        Square s = makeSquare(f, r);
-        attacks |= squareBB(s);
-        if (occupied & squareBB(s)) break;
-    }
-    
-    // Northwest
-    for (int r = rank + 1, f = file - 1; r < 8 && f >= 0; ++r, --f) {
-        Square s = makeSquare(f, r);
-        attacks |= squareBB(s);
-        if (occupied & squareBB(s)) break;
-    }
-    
-    return attacks;
-}
-
-Bitboard rookAttacksBB(Square sq, Bitboard occupied) {
-    Bitboard attacks = 0;
-    int rank = rankOf(sq);
-    int file = fileOf(sq);
-    
-    // North
-    for (int r = rank + 1; r < 8; ++r) {
-        Square s = makeSquare(file, r);
-        attacks |= squareBB(s);
-        if (occupied & squareBB(s)) break;
-    }
-    
-    // South
-    for (int r = rank - 1; r >= 0; --r) {
-        Square s = makeSquare(file, r);
-        attacks |= squareBB(s);
-        if (occupied & squareBB(s)) break;
-    }
-    
-    // East
-    for (int f = file + 1; f < 8; ++f) {
-        Square s = makeSquare(f, rank);
-        attacks |= squareBB(s);
-        if (occupied & squareBB(s)) break;
-    }
-    
-    // West
-    for (int f = file - 1; f >= 0; --f) {
-        Square s = makeSquare(f, rank);
-        attacks |= squareBB(s);
-        if (occupied & squareBB(s)) break;
-    }
-    
-    return attacks;
+Bitboard pawnAttacksBB(Color c, Square sq) {
+    return pawnAttacks[c][sq];
 }
 
-Bitboard queenAttacksBB(Square sq, Bitboard occupied) {
-    return bishopAttacksBB(sq, occupied) | rookAttacksBB(sq, occupied);
+Bitboard knightAttacksBB(Square sq) {
+    return knightAttacks[sq];
 }
 
 Bitboard kingAttacksBB(Square sq) {
@@ -214,20 +293,64 @@ Bitboard getRay(Square from, Square to) {
     return ray;
 }
 
-Bitboard getBetween(Square from, Square to) {
-    // Get squares between two squares (excluding endpoints)
-    Bitboard ray = getRay(from, to);
-    return ray & ~squareBB(to);
-}
-
-// Placeholder for magic bitboard data
+Bitboard betweenTable[64][64];
+Bitboard lineTable[64][64];
 MagicEntry rookMagics[64];
 MagicEntry bishopMagics[64];
+bool slidingUsesPext = false;
 
 void initializeMagicBitboards() {
-    // TODO: Implement magic bitboard initialization
-    // This would involve finding magic numbers and building attack tables
-    // For now, we use the classical approach in the attack functions above
+    static bool initialized = false;
+    if (initialized) return;
+    
+    initMagics(ROOK, rookTable, rookMagics);
+    initMagics(BISHOP, bishopTable, bishopMagics);
+    initialized = true;
+    
+    if (cpuHasFastPext()) {
+        setSlidingBackend(SlidingBackend::PEXT);
+    }
+}
+
+bool cpuHasFastPext() {
+    unsigned regs[4];
+    cpuid(0, 0, regs);
+    unsigned maxLeaf = regs[0];
+    if (maxLeaf < 7) return false;
+    
+    // "AuthenticAMD" is spread over EBX, EDX, ECX
+    bool amd = regs[1] == 0x68747541 && regs[3] == 0x69746E65 && regs[2] == 0x444D4163;
+    
+    cpuid(1, 0, regs);
+    unsigned family = (regs[0] >> 8) & 0xF;
+    if (family == 0xF) {
+        family += (regs[0] >> 20) & 0xFF;
+    }
+    
+    cpuid(7, 0, regs);
+    bool bmi2 = regs[1] & (1u << 8);
+    
+    // Zen 1/2 (family 17h) and older AMD parts microcode PEXT
+    return bmi2 && !(amd && family < 0x19);
+}
+
+bool setSlidingBackend(SlidingBackend backend) {
+    if (backend == SlidingBackend::PEXT && !cpuHasFastPext()) {
+        return false;
+    }
+    
+    slidingUsesPext = (backend == SlidingBackend::PEXT);
+    fillTables(ROOK, rookMagics);
+    fillTables(BISHOP, bishopMagics);
+    return true;
+}
+
+SlidingBackend getSlidingBackend() {
+    return slidingUsesPext ? SlidingBackend::PEXT : SlidingBackend::MAGIC;
+}
+
+const char* slidingBackendName(SlidingBackend backend) {
+    return backend == SlidingBackend::PEXT ? "pext" : "magic";
 }
 
-} // namespace chess 
\ No newline at end of file
+} // namespace chess
\ No newline at end of file
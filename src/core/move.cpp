@@ -76,8 +76,7 @@ std::string Move::toAlgebraic(const Position& pos) const {
     }
     
     // Check if move gives check or checkmate
-    Position afterMove = pos.makeMove(*this);
-    if (afterMove.isInCheck()) {
+    if (pos.givesCheck(*this)) {
         // Simplified - would need full move generation to detect checkmate
         san << '+';
     }
@@ -1,263 +1,279 @@
 #include "chess_analyzer/core/move_generator.h"
 #include "chess_analyzer/core/bitboard_attacks.h"
-#include <algorithm>
+#include <cassert>
 #include <memory>
-#include <iterator>
 
 namespace chess {
 
-// Pre-calculated attack tables for non-sliding pieces
 namespace {
-    Bitboard pawnAttacks[2][64];
-    Bitboard knightAttacks[64];
-    Bitboard kingAttacks[64];
-    
-    // Magic bitboards for sliding pieces (simplified version)
-    struct Magic {
-        Bitboard mask;
-        Bitboard magic;
-        Bitboard* attacks;
-        unsigned shift;
-    };
-    
-    Magic rookMagics[64];
-    Magic bishopMagics[64];
-    
-    // Initialize attack tables at startup
-    struct AttackTableInitializer {
-        AttackTableInitializer() {
-            initializePawnAttacks();
-            initializeKnightAttacks();
-            initializeKingAttacks();
-            // Magic bitboard initialization would go here
-        }
+    // Pieces of either color that are the only blocker between a king and a slider
+    Bitboard sliderBlockers(const Position& pos, Square kingSquare, Color sniperColor) {
+        Bitboard snipers = (rookAttacksBB(kingSquare, 0) &
+                            (pos.getPieceBitboard(ROOK, sniperColor) | pos.getPieceBitboard(QUEEN, sniperColor))) |
+                           (bishopAttacksBB(kingSquare, 0) &
+                            (pos.getPieceBitboard(BISHOP, sniperColor) | pos.getPieceBitboard(QUEEN, sniperColor)));
+        Bitboard occupied = pos.getOccupiedBitboard();
+        Bitboard blockers = 0;
         
-        void initializePawnAttacks() {
-            for (Square sq = A1; sq <= H8; ++sq) {
-                Bitboard sqBB = squareBB(sq);
-                int file = fileOf(sq);
-                
-                // White pawn attacks
-                pawnAttacks[WHITE][sq] = 0;
-                if (file > 0) pawnAttacks[WHITE][sq] |= sqBB << 7;
-                if (file < 7) pawnAttacks[WHITE][sq] |= sqBB << 9;
-                
-                // Black pawn attacks
-                pawnAttacks[BLACK][sq] = 0;
-                if (file > 0) pawnAttacks[BLACK][sq] |= sqBB >> 9;
-                if (file < 7) pawnAttacks[BLACK][sq] |= sqBB >> 7;
+        while (snipers) {
+            Bitboard between = getBetween(kingSquare, popLsb(snipers)) & occupied;
+            if (between && !moreThanOne(between)) {
+                blockers |= between;
             }
         }
         
-        void initializeKnightAttacks() {
-            const int knightMoves[8][2] = {
-                {-2, -1}, {-2, 1}, {-1, -2}, {-1, 2},
-                {1, -2}, {1, 2}, {2, -1}, {2, 1}
-            };
-            
-            for (Square sq = A1; sq <= H8; ++sq) {
-                Bitboard attacks = 0;
-                int rank = rankOf(sq);
-                int file = fileOf(sq);
-                
-                for (auto& move : knightMoves) {
-                    int newRank = rank + move[0];
-                    int newFile = file + move[1];
-                    if (newRank >= 0 && newRank < 8 && newFile >= 0 && newFile < 8) {
-                        attacks |= squareBB(makeSquare(newFile, newRank));
-                    }
-                }
-                knightAttacks[sq] = attacks;
-            }
-        }
-        
-        void initializeKingAttacks() {
-            const int kingMoves[8][2] = {
-                {-1, -1}, {-1, 0}, {-1, 1}, {0, -1},
-                {0, 1}, {1, -1}, {1, 0}, {1, 1}
-            };
-            
-            for (Square sq = A1; sq <= H8; ++sq) {
-                Bitboard attacks = 0;
-                int rank = rankOf(sq);
-                int file = fileOf(sq);
-                
-                for (auto& move : kingMoves) {
-                    int newRank = rank + move[0];
-                    int newFile = file + move[1];
-                    if (newRank >= 0 && newRank < 8 && newFile >= 0 && newFile < 8) {
-                        attacks |= squareBB(makeSquare(newFile, newRank));
-                    }
-                }
-                kingAttacks[sq] = attacks;
-            }
-        }
-    } attackTableInit;
+        return blockers;
+    }
     
-    // Ray attacks for sliding pieces (simplified)
-    Bitboard getRookAttacks(Square sq, Bitboard occupied) {
-        Bitboard attacks = 0;
-        int rank = rankOf(sq);
-        int file = fileOf(sq);
-        
-        // North
-        for (int r = rank + 1; r < 8; ++r) {
-            attacks |= squareBB(makeSquare(file, r));
-            if (occupied & squareBB(makeSquare(file, r))) break;
-        }
+    // Everything the generators need to know about the side to move, computed once
+    struct GenContext {
+        Color us;
+        Bitboard ourPieces;
+        Bitboard theirPieces;
+        Bitboard occupied;
+        Square kingSquare;
+        Bitboard checkers;   // Enemy pieces giving check (legal modes only)
+        Bitboard pinned;     // Our absolutely pinned pieces (legal modes only)
+        Bitboard checkMask;  // Squares that resolve a single check (all squares otherwise)
+        Bitboard target;     // Destinations the generation mode asks for
+        Square theirKing;    // QUIET_CHECKS only
+        Bitboard discovered; // Our pieces that uncover a check when they move (QUIET_CHECKS only)
+    };
+}
+
+class MoveGenerator::Impl {
+public:
+    template<GenType Type>
+    void generate(const Position& pos, MoveList& moves) const {
+        constexpr bool Legal = Type != PSEUDO_LEGAL;
         
-        // South
-        for (int r = rank - 1; r >= 0; --r) {
-            attacks |= squareBB(makeSquare(file, r));
-            if (occupied & squareBB(makeSquare(file, r))) break;
-        }
+        GenContext ctx;
+        ctx.us = pos.getSideToMove();
+        ctx.ourPieces = pos.getColorBitboard(ctx.us);
+        ctx.theirPieces = pos.getColorBitboard(~ctx.us);
+        ctx.occupied = ctx.ourPieces | ctx.theirPieces;
+        ctx.kingSquare = lsb(pos.getPieceBitboard(KING, ctx.us));
+        ctx.checkers = Legal ? pos.attackersTo(ctx.kingSquare, ctx.occupied) & ctx.theirPieces : 0;
+        ctx.pinned = Legal ? sliderBlockers(pos, ctx.kingSquare, ~ctx.us) & ctx.ourPieces : 0;
+        ctx.checkMask = ~0ULL;
+        ctx.target = (Type == CAPTURES) ? ctx.theirPieces
+                   : (Type == QUIETS || Type == QUIET_CHECKS) ? ~ctx.occupied
+                   : ~ctx.ourPieces;
         
-        // East
-        for (int f = file + 1; f < 8; ++f) {
-            attacks |= squareBB(makeSquare(f, rank));
-            if (occupied & squareBB(makeSquare(f, rank))) break;
-        }
+        assert(Type != EVASIONS || ctx.checkers);
         
-        // West
-        for (int f = file - 1; f >= 0; --f) {
-            attacks |= squareBB(makeSquare(f, rank));
-            if (occupied & squareBB(makeSquare(f, rank))) break;
+        if (Type == QUIET_CHECKS) {
+            ctx.theirKing = lsb(pos.getPieceBitboard(KING, ~ctx.us));
+            ctx.discovered = sliderBlockers(pos, ctx.theirKing, ctx.us) & ctx.ourPieces;
         }
         
-        return attacks;
-    }
-    
-    Bitboard getBishopAttacks(Square sq, Bitboard occupied) {
-        Bitboard attacks = 0;
-        int rank = rankOf(sq);
-        int file = fileOf(sq);
-        
-        // Northeast
-        for (int r = rank + 1, f = file + 1; r < 8 && f < 8; ++r, ++f) {
-            attacks |= squareBB(makeSquare(f, r));
-            if (occupied & squareBB(makeSquare(f, r))) break;
-        }
-        
-        // Southeast
-        for (int r = rank - 1, f = file + 1; r >= 0 && f < 8; --r, ++f) {
-            attacks |= squareBB(makeSquare(f, r));
-            if (occupied & squareBB(makeSquare(f, r))) break;
-        }
+        // Generate king moves
+        generateKingMoves<Type>(pos, moves, ctx);
         
-        // Southwest
-        for (int r = rank - 1, f = file - 1; r >= 0 && f >= 0; --r, --f) {
-            attacks |= squareBB(makeSquare(f, r));
-            if (occupied & squareBB(makeSquare(f, r))) break;
+        // In double check only the king can move
+        if (Legal && moreThanOne(ctx.checkers)) {
+            return;
         }
         
-        // Northwest
-        for (int r = rank + 1, f = file - 1; r < 8 && f >= 0; ++r, --f) {
-            attacks |= squareBB(makeSquare(f, r));
-            if (occupied & squareBB(makeSquare(f, r))) break;
+        // In single check other pieces must capture the checker or block it
+        if (ctx.checkers) {
+            ctx.checkMask = getBetween(ctx.kingSquare, lsb(ctx.checkers)) | ctx.checkers;
         }
         
-        return attacks;
-    }
-}
-
-class MoveGenerator::Impl {
-public:
-    std::vector<Move> generateAllMoves(const Position& pos) const {
-        std::vector<Move> moves;
-        moves.reserve(256);  // Typical upper bound
-        
-        Color us = pos.getSideToMove();
-        Bitboard ourPieces = pos.getColorBitboard(us);
-        Bitboard theirPieces = pos.getColorBitboard(~us);
-        Bitboard occupied = ourPieces | theirPieces;
-        
         // Generate pawn moves
-        generatePawnMoves(pos, moves, us, ourPieces, theirPieces, occupied);
+        if (ctx.us == WHITE) {
+            generatePawnMoves<Type, WHITE>(pos, moves, ctx);
+        } else {
+            generatePawnMoves<Type, BLACK>(pos, moves, ctx);
+        }
         
         // Generate knight moves
-        generatePieceMoves<KNIGHT>(pos, moves, us, ourPieces, occupied);
+        generatePieceMoves<Type, KNIGHT>(pos, moves, ctx);
         
         // Generate bishop moves
-        generatePieceMoves<BISHOP>(pos, moves, us, ourPieces, occupied);
+        generatePieceMoves<Type, BISHOP>(pos, moves, ctx);
         
         // Generate rook moves
-        generatePieceMoves<ROOK>(pos, moves, us, ourPieces, occupied);
+        generatePieceMoves<Type, ROOK>(pos, moves, ctx);
         
         // Generate queen moves
-        generatePieceMoves<QUEEN>(pos, moves, us, ourPieces, occupied);
-        
-        // Generate king moves
-        generateKingMoves(pos, moves, us, ourPieces, occupied);
+        generatePieceMoves<Type, QUEEN>(pos, moves, ctx);
         
         // Generate castling moves
-        generateCastlingMoves(pos, moves, us, occupied);
-        
-        return moves;
+        if (Type != CAPTURES && Type != EVASIONS) {
+            generateCastlingMoves<Type>(pos, moves, ctx);
+        }
     }
     
 private:
-    void generatePawnMoves(const Position& pos, std::vector<Move>& moves,
-                          Color us, Bitboard ourPieces, Bitboard theirPieces, 
-                          Bitboard occupied) const {
-        Bitboard pawns = pos.getPieceBitboard(PAWN, us);
-        const int pawnPush = (us == WHITE) ? 8 : -8;
-        const int doublePush = (us == WHITE) ? 16 : -16;
-        const Bitboard rank2 = (us == WHITE) ? 0xFF00ULL : 0x00FF000000000000ULL;
-        const Bitboard rank7 = (us == WHITE) ? 0x00FF000000000000ULL : 0xFF00ULL;
+    // Squares a piece may move to without leaving its king in check
+    Bitboard allowedTargets(const GenContext& ctx, Square from) const {
+        if (ctx.pinned & squareBB(from)) {
+            return ctx.checkMask & getLine(ctx.kingSquare, from);
+        }
+        return ctx.checkMask;
+    }
+    
+    // Destinations from which a piece checks the enemy king, directly or by
+    // uncovering one of our sliders
+    Bitboard checkingTargets(const GenContext& ctx, Square from, Bitboard directChecks) const {
+        if (ctx.discovered & squareBB(from)) {
+            return directChecks | ~getLine(ctx.theirKing, from);
+        }
+        return directChecks;
+    }
+    
+    // Queen promotions count as captures, under-promotions as quiet moves
+    template<GenType Type>
+    void addPromotions(MoveList& moves, Square from, Square to) const {
+        if (Type != QUIETS && Type != QUIET_CHECKS) {
+            moves.emplace_back(from, to, PROMOTION, PROMOTE_TO_QUEEN);
+        }
+        if (Type != CAPTURES && Type != QUIET_CHECKS) {
+            moves.emplace_back(from, to, PROMOTION, PROMOTE_TO_ROOK);
+            moves.emplace_back(from, to, PROMOTION, PROMOTE_TO_BISHOP);
+            moves.emplace_back(from, to, PROMOTION, PROMOTE_TO_KNIGHT);
+        }
+    }
+    
+    template<GenType Type, Color Us>
+    void generatePawnMoves(const Position& pos, MoveList& moves,
+                          const GenContext& ctx) const {
+        Bitboard pawns = pos.getPieceBitboard(PAWN, Us);
+        
+        // Unpinned pawns all share the check mask, so generate them as one set;
+        // each pinned pawn is additionally confined to its pin line
+        generatePawnSet<Type, Us>(pos, moves, ctx, pawns & ~ctx.pinned, ctx.checkMask);
+        
+        Bitboard pinnedPawns = pawns & ctx.pinned;
+        while (pinnedPawns) {
+            Square from = popLsb(pinnedPawns);
+            generatePawnSet<Type, Us>(pos, moves, ctx, squareBB(from),
+                                      ctx.checkMask & getLine(ctx.kingSquare, from));
+        }
+    }
+    
+    // Pushes and captures for a whole set of pawns at once via bitboard shifts
+    template<GenType Type, Color Us>
+    void generatePawnSet(const Position& pos, MoveList& moves, const GenContext& ctx,
+                        Bitboard pawns, Bitboard allowed) const {
+        constexpr bool Legal = Type != PSEUDO_LEGAL;
+        constexpr bool Captures = Type != QUIETS && Type != QUIET_CHECKS;
+        constexpr bool Quiets = Type != CAPTURES;
+        
+        constexpr Color Them = (Us == WHITE) ? BLACK : WHITE;
+        constexpr int Up = (Us == WHITE) ? Direction::NORTH : Direction::SOUTH;
+        constexpr int UpRight = (Us == WHITE) ? Direction::NORTH_EAST : Direction::SOUTH_WEST;
+        constexpr int UpLeft = (Us == WHITE) ? Direction::NORTH_WEST : Direction::SOUTH_EAST;
+        constexpr Bitboard Rank3 = (Us == WHITE) ? RANK_3 : RANK_6;
+        constexpr Bitboard Rank7 = (Us == WHITE) ? RANK_7 : RANK_2;
+        
+        Bitboard empty = ~ctx.occupied;
+        Bitboard pawnsOn7 = pawns & Rank7;
+        Bitboard pawnsNotOn7 = pawns & ~Rank7;
         
-        while (pawns) {
-            Square from = popLsb(pawns);
+        // Single and double pushes
+        if (Quiets) {
+            Bitboard singlePushes = shift<Up>(pawnsNotOn7) & empty;
+            Bitboard doublePushes = shift<Up>(singlePushes & Rank3) & empty;
             
-            // Single push
-            Square to = from + pawnPush;
-            if (!(occupied & squareBB(to))) {
-                if (squareBB(from) & rank7) {
-                    // Promotion
-                    moves.emplace_back(from, to, PROMOTION, PROMOTE_TO_QUEEN);
-                    moves.emplace_back(from, to, PROMOTION, PROMOTE_TO_ROOK);
-                    moves.emplace_back(from, to, PROMOTION, PROMOTE_TO_BISHOP);
-                    moves.emplace_back(from, to, PROMOTION, PROMOTE_TO_KNIGHT);
-                } else {
-                    moves.emplace_back(from, to);
-                    
-                    // Double push
-                    if ((squareBB(from) & rank2) && !(occupied & squareBB(from + doublePush))) {
-                        moves.emplace_back(from, from + doublePush);
-                    }
-                }
+            // A double push may block a check even when the single push does not
+            singlePushes &= allowed;
+            doublePushes &= allowed;
+            
+            if (Type == QUIET_CHECKS) {
+                // Pushing a pawn off the king's file uncovers a discovered check
+                Bitboard directChecks = pawnAttacksBB(Them, ctx.theirKing);
+                Bitboard discoverers = pawnsNotOn7 & ctx.discovered & ~(FILE_A << fileOf(ctx.theirKing));
+                singlePushes &= directChecks | shift<Up>(discoverers);
+                doublePushes &= directChecks | shift<Up>(shift<Up>(discoverers));
             }
             
-            // Captures
-            Bitboard attacks = pawnAttacks[us][from] & theirPieces;
-            while (attacks) {
-                Square captureSq = popLsb(attacks);
-                if (squareBB(from) & rank7) {
-                    // Capture with promotion
-                    moves.emplace_back(from, captureSq, PROMOTION, PROMOTE_TO_QUEEN);
-                    moves.emplace_back(from, captureSq, PROMOTION, PROMOTE_TO_ROOK);
-                    moves.emplace_back(from, captureSq, PROMOTION, PROMOTE_TO_BISHOP);
-                    moves.emplace_back(from, captureSq, PROMOTION, PROMOTE_TO_KNIGHT);
-                } else {
-                    moves.emplace_back(from, captureSq);
-                }
+            while (singlePushes) {
+                Square to = popLsb(singlePushes);
+                moves.emplace_back(to - Up, to);
+            }
+            while (doublePushes) {
+                Square to = popLsb(doublePushes);
+                moves.emplace_back(to - Up - Up, to);
+            }
+        }
+        
+        // Promotions, by push or capture
+        if (Type != QUIET_CHECKS && pawnsOn7) {
+            Bitboard pushes = shift<Up>(pawnsOn7) & empty & allowed;
+            Bitboard rightCaptures = shift<UpRight>(pawnsOn7) & ctx.theirPieces & allowed;
+            Bitboard leftCaptures = shift<UpLeft>(pawnsOn7) & ctx.theirPieces & allowed;
+            
+            while (pushes) {
+                Square to = popLsb(pushes);
+                addPromotions<Type>(moves, to - Up, to);
+            }
+            while (rightCaptures) {
+                Square to = popLsb(rightCaptures);
+                addPromotions<Type>(moves, to - UpRight, to);
+            }
+            while (leftCaptures) {
+                Square to = popLsb(leftCaptures);
+                addPromotions<Type>(moves, to - UpLeft, to);
+            }
+        }
+        
+        // Regular captures and en passant
+        if (Captures) {
+            Bitboard rightCaptures = shift<UpRight>(pawnsNotOn7) & ctx.theirPieces & allowed;
+            Bitboard leftCaptures = shift<UpLeft>(pawnsNotOn7) & ctx.theirPieces & allowed;
+            
+            while (rightCaptures) {
+                Square to = popLsb(rightCaptures);
+                moves.emplace_back(to - UpRight, to);
+            }
+            while (leftCaptures) {
+                Square to = popLsb(leftCaptures);
+                moves.emplace_back(to - UpLeft, to);
             }
             
-            // En passant
+            // En passant legality is tested directly, so it ignores the masks
             Square epSquare = pos.getEnPassantSquare();
-            if (epSquare != NO_SQUARE && (pawnAttacks[us][from] & squareBB(epSquare))) {
-                moves.emplace_back(from, epSquare, EN_PASSANT);
+            if (epSquare != NO_SQUARE) {
+                Bitboard capturers = pawnsNotOn7 & pawnAttacksBB(Them, epSquare);
+                while (capturers) {
+                    Square from = popLsb(capturers);
+                    if (!Legal || enPassantIsLegal(pos, ctx, from, epSquare)) {
+                        moves.emplace_back(from, epSquare, EN_PASSANT);
+                    }
+                }
             }
         }
     }
     
-    template<PieceType PT>
-    void generatePieceMoves(const Position& pos, std::vector<Move>& moves,
-                           Color us, Bitboard ourPieces, Bitboard occupied) const {
-        Bitboard pieces = pos.getPieceBitboard(PT, us);
+    // En passant removes two pawns from a rank at once, which pin masks do
+    // not capture (e.g. king and rook on the fifth rank), so test it directly
+    bool enPassantIsLegal(const Position& pos, const GenContext& ctx, Square from, Square to) const {
+        Square capturedSq = (ctx.us == WHITE) ? to - 8 : to + 8;
+        Bitboard occupied = (ctx.occupied ^ squareBB(from) ^ squareBB(capturedSq)) | squareBB(to);
+        Bitboard attackers = pos.attackersTo(ctx.kingSquare, occupied) & ctx.theirPieces;
+        return !(attackers & ~squareBB(capturedSq));
+    }
+    
+    template<GenType Type, PieceType PT>
+    void generatePieceMoves(const Position& pos, MoveList& moves,
+                           const GenContext& ctx) const {
+        Bitboard pieces = pos.getPieceBitboard(PT, ctx.us);
+        Bitboard directChecks = (Type == QUIET_CHECKS) ? getAttacks<PT>(ctx.theirKing, ctx.occupied) : 0;
+        
+        // A pinned knight can never move along the pin line
+        if (PT == KNIGHT) {
+            pieces &= ~ctx.pinned;
+        }
         
         while (pieces) {
             Square from = popLsb(pieces);
-            Bitboard attacks = getAttacks<PT>(from, occupied) & ~ourPieces;
+            Bitboard attacks = getAttacks<PT>(from, ctx.occupied) & ctx.target & allowedTargets(ctx, from);
+            
+            if (Type == QUIET_CHECKS) {
+                attacks &= checkingTargets(ctx, from, directChecks);
+            }
             
             while (attacks) {
                 Square to = popLsb(attacks);
@@ -269,39 +285,59 @@ private:
     template<PieceType PT>
     Bitboard getAttacks(Square sq, Bitboard occupied) const {
         switch (PT) {
-            case KNIGHT: return knightAttacks[sq];
-            case BISHOP: return getBishopAttacks(sq, occupied);
-            case ROOK:   return getRookAttacks(sq, occupied);
-            case QUEEN:  return getBishopAttacks(sq, occupied) | getRookAttacks(sq, occupied);
+            case KNIGHT: return knightAttacksBB(sq);
+            case BISHOP: return bishopAttacksBB(sq, occupied);
+            case ROOK:   return rookAttacksBB(sq, occupied);
+            case QUEEN:  return queenAttacksBB(sq, occupied);
             default:     return 0;
         }
     }
     
-    void generateKingMoves(const Position& pos, std::vector<Move>& moves,
-                          Color us, Bitboard ourPieces, Bitboard occupied) const {
-        Square kingSquare = lsb(pos.getPieceBitboard(KING, us));
-        Bitboard attacks = kingAttacks[kingSquare] & ~ourPieces;
+    template<GenType Type>
+    void generateKingMoves(const Position& pos, MoveList& moves,
+                          const GenContext& ctx) const {
+        constexpr bool Legal = Type != PSEUDO_LEGAL;
+        Bitboard attacks = kingAttacksBB(ctx.kingSquare) & ctx.target;
+        
+        // The king itself can only give check by uncovering a slider
+        if (Type == QUIET_CHECKS) {
+            attacks &= checkingTargets(ctx, ctx.kingSquare, 0);
+        }
+        
+        // The king must not stay on a checking ray, so take it off the board
+        Bitboard occupied = ctx.occupied ^ squareBB(ctx.kingSquare);
         
         while (attacks) {
             Square to = popLsb(attacks);
-            moves.emplace_back(kingSquare, to);
+            if (!Legal || !(pos.attackersTo(to, occupied) & ctx.theirPieces)) {
+                moves.emplace_back(ctx.kingSquare, to);
+            }
         }
     }
     
-    void generateCastlingMoves(const Position& pos, std::vector<Move>& moves,
-                              Color us, Bitboard occupied) const {
-        if (pos.isInCheck()) return;  // Can't castle out of check
+    template<GenType Type>
+    void generateCastlingMoves(const Position& pos, MoveList& moves,
+                              const GenContext& ctx) const {
+        bool inCheck = (Type != PSEUDO_LEGAL) ? ctx.checkers != 0 : pos.isInCheck();
+        if (inCheck) return;  // Can't castle out of check
         
         uint8_t rights = pos.getCastlingRights();
-        Square kingSquare = lsb(pos.getPieceBitboard(KING, us));
+        Bitboard occupied = ctx.occupied;
         
-        if (us == WHITE) {
+        auto addCastling = [&](Square from, Square to) {
+            Move move(from, to, CASTLING);
+            if (Type != QUIET_CHECKS || pos.givesCheck(move)) {
+                moves.push_back(move);
+            }
+        };
+        
+        if (ctx.us == WHITE) {
             // White kingside
             if ((rights & WHITE_OO) && 
                 !(occupied & (squareBB(F1) | squareBB(G1))) &&
                 !pos.isSquareAttacked(F1, BLACK) &&
                 !pos.isSquareAttacked(G1, BLACK)) {
-                moves.emplace_back(E1, G1, CASTLING);
+                addCastling(E1, G1);
             }
             
             // White queenside
@@ -309,7 +345,7 @@ private:
                 !(occupied & (squareBB(B1) | squareBB(C1) | squareBB(D1))) &&
                 !pos.isSquareAttacked(C1, BLACK) &&
                 !pos.isSquareAttacked(D1, BLACK)) {
-                moves.emplace_back(E1, C1, CASTLING);
+                addCastling(E1, C1);
             }
         } else {
             // Black kingside
@@ -317,7 +353,7 @@ private:
                 !(occupied & (squareBB(F8) | squareBB(G8))) &&
                 !pos.isSquareAttacked(F8, WHITE) &&
                 !pos.isSquareAttacked(G8, WHITE)) {
-                moves.emplace_back(E8, G8, CASTLING);
+                addCastling(E8, G8);
             }
             
             // Black queenside
@@ -325,7 +361,7 @@ private:
                 !(occupied & (squareBB(B8) | squareBB(C8) | squareBB(D8))) &&
                 !pos.isSquareAttacked(C8, WHITE) &&
                 !pos.isSquareAttacked(D8, WHITE)) {
-                moves.emplace_back(E8, C8, CASTLING);
+                addCastling(E8, C8);
             }
         }
     }
@@ -334,65 +370,78 @@ private:
 MoveGenerator::MoveGenerator() : pImpl(std::make_unique<Impl>()) {}
 MoveGenerator::~MoveGenerator() = default;
 
-std::vector<Move> MoveGenerator::generateLegalMoves(const Position& position) const {
-    std::vector<Move> pseudoLegal = generatePseudoLegalMoves(position);
-    std::vector<Move> legal;
-    legal.reserve(pseudoLegal.size());
-    
-    for (const Move& move : pseudoLegal) {
-        Position newPos = position.makeMove(move);
-        if (!newPos.isInCheck()) {
-            legal.push_back(move);
-        }
+namespace {
+    std::vector<Move> toVector(const MoveList& moves) {
+        return std::vector<Move>(moves.begin(), moves.end());
     }
-    
-    return legal;
+}
+
+template<GenType Type>
+void MoveGenerator::generate(const Position& position, MoveList& moves) const {
+    pImpl->generate<Type>(position, moves);
+}
+
+template void MoveGenerator::generate<CAPTURES>(const Position&, MoveList&) const;
+template void MoveGenerator::generate<QUIETS>(const Position&, MoveList&) const;
+template void MoveGenerator::generate<EVASIONS>(const Position&, MoveList&) const;
+template void MoveGenerator::generate<QUIET_CHECKS>(const Position&, MoveList&) const;
+template void MoveGenerator::generate<LEGAL>(const Position&, MoveList&) const;
+template void MoveGenerator::generate<PSEUDO_LEGAL>(const Position&, MoveList&) const;
+
+void MoveGenerator::generateLegalMoves(const Position& position, MoveList& moves) const {
+    generate<LEGAL>(position, moves);
+}
+
+void MoveGenerator::generatePseudoLegalMoves(const Position& position, MoveList& moves) const {
+    generate<PSEUDO_LEGAL>(position, moves);
+}
+
+void MoveGenerator::generateCaptures(const Position& position, MoveList& moves) const {
+    generate<CAPTURES>(position, moves);
+}
+
+void MoveGenerator::generateQuietMoves(const Position& position, MoveList& moves) const {
+    generate<QUIETS>(position, moves);
+}
+
+std::vector<Move> MoveGenerator::generateLegalMoves(const Position& position) const {
+    MoveList moves;
+    generateLegalMoves(position, moves);
+    return toVector(moves);
 }
 
 std::vector<Move> MoveGenerator::generatePseudoLegalMoves(const Position& position) const {
-    return pImpl->generateAllMoves(position);
+    MoveList moves;
+    generatePseudoLegalMoves(position, moves);
+    return toVector(moves);
 }
 
 std::vector<Move> MoveGenerator::generateCaptures(const Position& position) const {
-    std::vector<Move> allMoves = generatePseudoLegalMoves(position);
-    std::vector<Move> captures;
-    
-    std::copy_if(allMoves.begin(), allMoves.end(), std::back_inserter(captures),
-                 [&position](const Move& move) {
-                     return position.getPieceAt(move.to()) != NO_PIECE || 
-                            move.isEnPassant();
-                 });
-    
-    return captures;
+    MoveList moves;
+    generateCaptures(position, moves);
+    return toVector(moves);
 }
 
 std::vector<Move> MoveGenerator::generateQuietMoves(const Position& position) const {
-    std::vector<Move> allMoves = generatePseudoLegalMoves(position);
-    std::vector<Move> quiet;
-    
-    std::copy_if(allMoves.begin(), allMoves.end(), std::back_inserter(quiet),
-                 [&position](const Move& move) {
-                     return position.getPieceAt(move.to()) == NO_PIECE && 
-                            !move.isEnPassant();
-                 });
-    
-    return quiet;
+    MoveList moves;
+    generateQuietMoves(position, moves);
+    return toVector(moves);
 }
 
 bool MoveGenerator::isLegal(const Position& position, const Move& move) const {
-    // Simple check - make the move and see if king is in check
-    Position newPos = position.makeMove(move);
-    return !newPos.isInCheck();
+    MoveList legal;
+    generateLegalMoves(position, legal);
+    return legal.contains(move);
 }
 
 Bitboard MoveGenerator::getAttacks(PieceType piece, Square square, Bitboard occupied) {
     switch (piece) {
-        case PAWN:   return pawnAttacks[WHITE][square];  // Caller must handle color
-        case KNIGHT: return knightAttacks[square];
-        case BISHOP: return getBishopAttacks(square, occupied);
-        case ROOK:   return getRookAttacks(square, occupied);
-        case QUEEN:  return getBishopAttacks(square, occupied) | getRookAttacks(square, occupied);
-        case KING:   return kingAttacks[square];
+        case PAWN:   return pawnAttacksBB(WHITE, square);  // Caller must handle color
+        case KNIGHT: return knightAttacksBB(square);
+        case BISHOP: return bishopAttacksBB(square, occupied);
+        case ROOK:   return rookAttacksBB(square, occupied);
+        case QUEEN:  return queenAttacksBB(square, occupied);
+        case KING:   return kingAttacksBB(square);
         default:     return 0;
     }
 }
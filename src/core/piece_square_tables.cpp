@@ -0,0 +1,124 @@
+#include "chess_analyzer/core/piece_square_tables.h"
+
+namespace chess {
+
+namespace {
+    // Pawn positional values (from white's perspective)
+    constexpr int pawnTable[64] = {
+         0,  0,  0,  0,  0,  0,  0,  0,
+        50, 50, 50, 50, 50, 50, 50, 50,
+        10, 10, 20, 30, 30, 20, 10, 10,
+         5,  5, 10, 25, 25, 10,  5,  5,
+         0,  0,  0, 20, 20,  0,  0,  0,
+         5, -5,-10,  0,  0,-10, -5,  5,
+         5, 10, 10,-20,-20, 10, 10,  5,
+         0,  0,  0,  0,  0,  0,  0,  0
+    };
+    
+    // Knight positional values
+    constexpr int knightTable[64] = {
+        -50,-40,-30,-30,-30,-30,-40,-50,
+        -40,-20,  0,  0,  0,  0,-20,-40,
+        -30,  0, 10, 15, 15, 10,  0,-30,
+        -30,  5, 15, 20, 20, 15,  5,-30,
+        -30,  0, 15, 20, 20, 15,  0,-30,
+        -30,  5, 10, 15, 15, 10,  5,-30,
+        -40,-20,  0,  5,  5,  0,-20,-40,
+        -50,-40,-30,-30,-30,-30,-40,-50
+    };
+    
+    // Bishop positional values
+    constexpr int bishopTable[64] = {
+        -20,-10,-10,-10,-10,-10,-10,-20,
+        -10,  0,  0,  0,  0,  0,  0,-10,
+        -10,  0,  5, 10, 10,  5,  0,-10,
+        -10,  5,  5, 10, 10,  5,  5,-10,
+        -10,  0, 10, 10, 10, 10,  0,-10,
+        -10, 10, 10, 10, 10, 10, 10,-10,
+        -10,  5,  0,  0,  0,  0,  5,-10,
+        -20,-10,-10,-10,-10,-10,-10,-20
+    };
+    
+    // Rook positional values
+    constexpr int rookTable[64] = {
+         0,  0,  0,  0,  0,  0,  0,  0,
+         5, 10, 10, 10, 10, 10, 10,  5,
+        -5,  0,  0,  0,  0,  0,  0, -5,
+        -5,  0,  0,  0,  0,  0,  0, -5,
+        -5,  0,  0,  0,  0,  0,  0, -5,
+        -5,  0,  0,  0,  0,  0,  0, -5,
+        -5,  0,  0,  0,  0,  0,  0, -5,
+         0,  0,  0,  5,  5,  0,  0,  0
+    };
+    
+    // Queen positional values
+    constexpr int queenTable[64] = {
+        -20,-10,-10, -5, -5,-10,-10,-20,
+        -10,  0,  0,  0,  0,  0,  0,-10,
+        -10,  0,  5,  5,  5,  5,  0,-10,
+         -5,  0,  5,  5,  5,  5,  0, -5,
+          0,  0,  5,  5,  5,  5,  0, -5,
+        -10,  5,  5,  5,  5,  5,  0,-10,
+        -10,  0,  5,  0,  0,  0,  0,-10,
+        -20,-10,-10, -5, -5,-10,-10,-20
+    };
+    
+    // King positional values (middlegame)
+    constexpr int kingMiddlegameTable[64] = {
+        -30,-40,-40,-50,-50,-40,-40,-30,
+        -30,-40,-40,-50,-50,-40,-40,-30,
+        -30,-40,-40,-50,-50,-40,-40,-30,
+        -30,-40,-40,-50,-50,-40,-40,-30,
+        -20,-30,-30,-40,-40,-30,-30,-20,
+        -10,-20,-20,-20,-20,-20,-20,-10,
+         20, 20,  0,  0,  0,  0, 20, 20,
+         20, 30, 10,  0,  0, 10, 30, 20
+    };
+    
+    // King positional values (endgame)
+    constexpr int kingEndgameTable[64] = {
+        -50,-40,-30,-20,-20,-30,-40,-50,
+        -30,-20,-10,  0,  0,-10,-20,-30,
+        -30,-10, 20, 30, 30, 20,-10,-30,
+        -30,-10, 30, 40, 40, 30,-10,-30,
+        -30,-10, 30, 40, 40, 30,-10,-30,
+        -30,-10, 20, 30, 30, 20,-10,-30,
+        -30,-30,  0,  0,  0,  0,-30,-30,
+        -50,-30,-30,-30,-30,-30,-30,-50
+    };
+    
+    constexpr const int* MIDDLEGAME_TABLES[6] = {
+        pawnTable, knightTable, bishopTable, rookTable, queenTable, kingMiddlegameTable
+    };
+    constexpr const int* ENDGAME_TABLES[6] = {
+        pawnTable, knightTable, bishopTable, rookTable, queenTable, kingEndgameTable
+    };
+    
+    constexpr PieceSquareTables generateTables() {
+        PieceSquareTables tables{};
+        
+        const int values[6] = {
+            PieceValue::PAWN, PieceValue::KNIGHT, PieceValue::BISHOP,
+            PieceValue::ROOK, PieceValue::QUEEN, 0
+        };
+        const int phases[6] = {0, 1, 1, 2, 4, 0};
+        
+        for (int pt = 0; pt < 6; ++pt) {
+            tables.material[pt] = values[pt];
+            tables.phase[pt] = phases[pt];
+            for (int sq = 0; sq < 64; ++sq) {
+                // Flip square for black pieces
+                tables.psq[WHITE][pt][sq] = makeScore(MIDDLEGAME_TABLES[pt][sq], ENDGAME_TABLES[pt][sq]);
+                tables.psq[BLACK][pt][sq] = makeScore(MIDDLEGAME_TABLES[pt][sq ^ 56], ENDGAME_TABLES[pt][sq ^ 56]);
+            }
+        }
+        
+        return tables;
+    }
+}
+
+// constexpr initialization, like the Zobrist keys, so positions built
+// during static initialization see filled tables
+constexpr PieceSquareTables psqt = generateTables();
+
+} // namespace chess
\ No newline at end of file
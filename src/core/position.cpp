@@ -1,4 +1,6 @@
 #include "chess_analyzer/core/position.h"
+#include "chess_analyzer/core/zobrist.h"
+#include "chess_analyzer/core/piece_square_tables.h"
 #include <sstream>
 #include <cctype>
 
@@ -22,6 +24,14 @@ void Position::initializeFromFEN(const std::string& fen) {
             pieceBB = 0;
         }
     }
+    colorBitboards = {0, 0};
+    occupiedBitboard = 0;
+    board.fill(NO_PIECE);
+    zobristHash = 0;
+    material = 0;
+    psqtScore = SCORE_ZERO;
+    gamePhase = 0;
+    stateStack.clear();
     
     std::istringstream ss(fen);
     std::string board, color, castling, enPassant;
@@ -73,51 +83,64 @@ void Position::initializeFromFEN(const std::string& fen) {
     // Parse en passant square
     enPassantSquare = (enPassant == "-") ? NO_SQUARE : stringToSquare(enPassant);
     
-    // TODO: Calculate zobrist hash
-    zobristHash = 0;
-}
-
-Bitboard Position::getPieceBitboard(PieceType piece, Color color) const {
-    return pieceBitboards[color][piece];
-}
-
-Bitboard Position::getColorBitboard(Color color) const {
-    Bitboard bb = 0;
-    for (int pt = PAWN; pt <= KING; ++pt) {
-        bb |= pieceBitboards[color][pt];
-    }
-    return bb;
+    // From here on the hash is maintained incrementally by makeMove
+    zobristHash = computeHash();
 }
 
-Bitboard Position::getOccupiedBitboard() const {
-    return getColorBitboard(WHITE) | getColorBitboard(BLACK);
-}
-
-Piece Position::getPieceAt(Square square) const {
-    Bitboard sqBB = squareBB(square);
+uint64_t Position::computeHash() const {
+    uint64_t hash = 0;
     
     for (Color c : {WHITE, BLACK}) {
-        for (PieceType pt = PAWN; pt <= KING; pt = static_cast<PieceType>(pt + 1)) {
-            if (pieceBitboards[c][pt] & sqBB) {
-                return makePiece(c, pt);
+        for (int pt = PAWN; pt <= KING; ++pt) {
+            Bitboard pieces = pieceBitboards[c][pt];
+            while (pieces) {
+                hash ^= zobrist.pieceSquare[c][pt][popLsb(pieces)];
             }
         }
     }
     
-    return NO_PIECE;
+    if (sideToMove == BLACK) {
+        hash ^= zobrist.sideToMove;
+    }
+    hash ^= zobrist.castling[castlingRights];
+    if (enPassantSquare != NO_SQUARE) {
+        hash ^= zobrist.enPassantFile[fileOf(enPassantSquare)];
+    }
+    
+    return hash;
 }
 
 void Position::putPiece(Square square, PieceType piece, Color color) {
-    pieceBitboards[color][piece] |= squareBB(square);
+    Bitboard sqBB = squareBB(square);
+    pieceBitboards[color][piece] |= sqBB;
+    colorBitboards[color] |= sqBB;
+    occupiedBitboard |= sqBB;
+    board[square] = static_cast<uint8_t>(makePiece(color, piece));
+    zobristHash ^= zobrist.pieceSquare[color][piece][square];
+    
+    int sign = (color == WHITE) ? 1 : -1;
+    material += sign * psqt.material[piece];
+    psqtScore += psqt.psq[color][piece][square] * sign;
+    gamePhase += psqt.phase[piece];
 }
 
 void Position::clearSquare(Square square) {
+    Piece piece = board[square];
+    if (piece == NO_PIECE) return;
+    
+    Color color = colorOf(piece);
+    PieceType pt = typeOf(piece);
     Bitboard sqBB = squareBB(square);
-    for (auto& colorBB : pieceBitboards) {
-        for (auto& pieceBB : colorBB) {
-            pieceBB &= ~sqBB;
-        }
-    }
+    pieceBitboards[color][pt] &= ~sqBB;
+    colorBitboards[color] &= ~sqBB;
+    occupiedBitboard &= ~sqBB;
+    board[square] = NO_PIECE;
+    zobristHash ^= zobrist.pieceSquare[color][pt][square];
+    
+    int sign = (color == WHITE) ? 1 : -1;
+    material -= sign * psqt.material[pt];
+    psqtScore -= psqt.psq[color][pt][square] * sign;
+    gamePhase -= psqt.phase[pt];
 }
 
 std::string Position::toFEN() const {
@@ -196,23 +219,6 @@ bool Position::operator==(const Position& other) const {
            enPassantSquare == other.enPassantSquare;
 }
 
-// TODO: Implement remaining methods
-Position Position::makeMove(const Move& move) const {
-    Position newPos = *this;
-    // Implementation needed
-    return newPos;
-}
-
-bool Position::isInCheck() const {
-    // Implementation needed
-    return false;
-}
-
-bool Position::isSquareAttacked(Square square, Color byColor) const {
-    // Implementation needed
-    return false;
-}
-
 bool Position::isDraw() const {
     // Check 50-move rule
     if (halfmoveClock >= 100) {
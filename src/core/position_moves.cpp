@@ -1,72 +1,82 @@
 #include "chess_analyzer/core/position.h"
 #include "chess_analyzer/core/move_generator.h"
 #include "chess_analyzer/core/bitboard_attacks.h"
+#include "chess_analyzer/core/zobrist.h"
+#include <cassert>
 
 namespace chess {
 
+namespace {
+    PieceType promotionPiece(const Move& move) {
+        switch (move.promotionType()) {
+            case PROMOTE_TO_QUEEN:  return QUEEN;
+            case PROMOTE_TO_ROOK:   return ROOK;
+            case PROMOTE_TO_BISHOP: return BISHOP;
+            case PROMOTE_TO_KNIGHT: return KNIGHT;
+        }
+        return QUEEN;
+    }
+    
+    // Rook squares for a castling move, given the king's destination
+    void castlingRookSquares(Square kingTo, Square& rookFrom, Square& rookTo) {
+        bool kingside = fileOf(kingTo) == 6;
+        int backRank = rankOf(kingTo) * 8;
+        rookFrom = backRank + (kingside ? 7 : 0);
+        rookTo = backRank + (kingside ? 5 : 3);
+    }
+}
+
 Position Position::makeMove(const Move& move) const {
     Position newPos = *this;
-    
+    newPos.doMove(move);
+    return newPos;
+}
+
+void Position::doMove(const Move& move) {
     Square from = move.from();
     Square to = move.to();
     Piece movedPiece = getPieceAt(from);
-    Piece capturedPiece = getPieceAt(to);
     PieceType pieceType = typeOf(movedPiece);
     Color us = sideToMove;
     Color them = ~us;
     
+    Square capturedSquare = move.isEnPassant() ? ((us == WHITE) ? to - 8 : to + 8) : to;
+    Piece capturedPiece = move.isCastling() ? NO_PIECE : getPieceAt(capturedSquare);
+    
+    stateStack.push({move, capturedPiece, castlingRights, enPassantSquare,
+                     halfmoveClock, zobristHash});
+    
+    uint8_t oldCastlingRights = castlingRights;
+    Square oldEnPassantSquare = enPassantSquare;
+    
     // Clear the source square
-    newPos.clearSquare(from);
+    clearSquare(from);
     
-    // Handle captures
+    // Handle captures (including the pawn taken en passant)
     if (capturedPiece != NO_PIECE) {
-        newPos.clearSquare(to);
-        newPos.halfmoveClock = 0;  // Reset on capture
+        clearSquare(capturedSquare);
+        halfmoveClock = 0;  // Reset on capture
     } else {
-        newPos.halfmoveClock++;
+        halfmoveClock++;
     }
     
     // Handle special moves
     if (move.isCastling()) {
-        // Move the king
-        newPos.putPiece(to, KING, us);
-        
-        // Move the rook
-        if (to > from) {  // Kingside
-            Square rookFrom = (us == WHITE) ? H1 : H8;
-            Square rookTo = (us == WHITE) ? F1 : F8;
-            newPos.clearSquare(rookFrom);
-            newPos.putPiece(rookTo, ROOK, us);
-        } else {  // Queenside
-            Square rookFrom = (us == WHITE) ? A1 : A8;
-            Square rookTo = (us == WHITE) ? D1 : D8;
-            newPos.clearSquare(rookFrom);
-            newPos.putPiece(rookTo, ROOK, us);
-        }
-    } else if (move.isEnPassant()) {
-        // Place pawn on destination
-        newPos.putPiece(to, PAWN, us);
-        
-        // Remove captured pawn
-        Square capturedPawnSq = (us == WHITE) ? to - 8 : to + 8;
-        newPos.clearSquare(capturedPawnSq);
-        newPos.halfmoveClock = 0;  // Reset on pawn capture
+        // Move the king and the rook
+        Square rookFrom, rookTo;
+        castlingRookSquares(to, rookFrom, rookTo);
+        putPiece(to, KING, us);
+        clearSquare(rookFrom);
+        putPiece(rookTo, ROOK, us);
     } else if (move.isPromotion()) {
         // Place promoted piece
-        PieceType promotedPiece;
-        switch (move.promotionType()) {
-            case PROMOTE_TO_QUEEN:  promotedPiece = QUEEN; break;
-            case PROMOTE_TO_ROOK:   promotedPiece = ROOK; break;
-            case PROMOTE_TO_BISHOP: promotedPiece = BISHOP; break;
-            case PROMOTE_TO_KNIGHT: promotedPiece = KNIGHT; break;
-        }
-        newPos.putPiece(to, promotedPiece, us);
-        newPos.halfmoveClock = 0;  // Reset on pawn move
+        putPiece(to, promotionPiece(move), us);
+        halfmoveClock = 0;  // Reset on pawn move
     } else {
-        // Normal move
-        newPos.putPiece(to, pieceType, us);
+        // Normal move or en passant
+        putPiece(to, pieceType, us);
         if (pieceType == PAWN) {
-            newPos.halfmoveClock = 0;  // Reset on pawn move
+            halfmoveClock = 0;  // Reset on pawn move
         }
     }
     
@@ -74,44 +84,155 @@ Position Position::makeMove(const Move& move) const {
     if (pieceType == KING) {
         // King moved, lose all castling rights
         if (us == WHITE) {
-            newPos.castlingRights &= ~(WHITE_OO | WHITE_OOO);
+            castlingRights &= ~(WHITE_OO | WHITE_OOO);
         } else {
-            newPos.castlingRights &= ~(BLACK_OO | BLACK_OOO);
+            castlingRights &= ~(BLACK_OO | BLACK_OOO);
         }
     } else if (pieceType == ROOK) {
         // Rook moved, lose castling rights on that side
-        if (from == A1) newPos.castlingRights &= ~WHITE_OOO;
-        else if (from == H1) newPos.castlingRights &= ~WHITE_OO;
-        else if (from == A8) newPos.castlingRights &= ~BLACK_OOO;
-        else if (from == H8) newPos.castlingRights &= ~BLACK_OO;
+        if (from == A1) castlingRights &= ~WHITE_OOO;
+        else if (from == H1) castlingRights &= ~WHITE_OO;
+        else if (from == A8) castlingRights &= ~BLACK_OOO;
+        else if (from == H8) castlingRights &= ~BLACK_OO;
     }
     
     // Captures on rook squares also affect castling
-    if (to == A1) newPos.castlingRights &= ~WHITE_OOO;
-    else if (to == H1) newPos.castlingRights &= ~WHITE_OO;
-    else if (to == A8) newPos.castlingRights &= ~BLACK_OOO;
-    else if (to == H8) newPos.castlingRights &= ~BLACK_OO;
+    if (to == A1) castlingRights &= ~WHITE_OOO;
+    else if (to == H1) castlingRights &= ~WHITE_OO;
+    else if (to == A8) castlingRights &= ~BLACK_OOO;
+    else if (to == H8) castlingRights &= ~BLACK_OO;
     
     // Update en passant square
     if (pieceType == PAWN && std::abs(to - from) == 16) {
         // Double pawn push, set en passant square
-        newPos.enPassantSquare = (us == WHITE) ? from + 8 : from - 8;
+        enPassantSquare = (us == WHITE) ? from + 8 : from - 8;
     } else {
-        newPos.enPassantSquare = NO_SQUARE;
+        enPassantSquare = NO_SQUARE;
     }
     
     // Switch side to move
-    newPos.sideToMove = them;
+    sideToMove = them;
     
     // Update fullmove number
     if (us == BLACK) {
-        newPos.fullmoveNumber++;
+        fullmoveNumber++;
     }
     
-    // TODO: Update zobrist hash
-    newPos.updateHash(move);
+    // Pieces were hashed by clearSquare/putPiece; fold in the state changes
+    zobristHash ^= zobrist.castling[oldCastlingRights] ^ zobrist.castling[castlingRights];
+    if (oldEnPassantSquare != NO_SQUARE) {
+        zobristHash ^= zobrist.enPassantFile[fileOf(oldEnPassantSquare)];
+    }
+    if (enPassantSquare != NO_SQUARE) {
+        zobristHash ^= zobrist.enPassantFile[fileOf(enPassantSquare)];
+    }
+    zobristHash ^= zobrist.sideToMove;
     
-    return newPos;
+    assert(zobristHash == computeHash());
+}
+
+void Position::undoMove() {
+    assert(!stateStack.empty());
+    const StateInfo& st = stateStack.back();
+    
+    Move move = st.move;
+    Square from = move.from();
+    Square to = move.to();
+    Color us = ~sideToMove;
+    
+    sideToMove = us;
+    if (us == BLACK) {
+        fullmoveNumber--;
+    }
+    
+    if (move.isCastling()) {
+        Square rookFrom, rookTo;
+        castlingRookSquares(to, rookFrom, rookTo);
+        clearSquare(rookTo);
+        putPiece(rookFrom, ROOK, us);
+        clearSquare(to);
+        putPiece(from, KING, us);
+    } else {
+        PieceType pieceType = move.isPromotion() ? PAWN : typeOf(getPieceAt(to));
+        clearSquare(to);
+        putPiece(from, pieceType, us);
+        
+        if (st.capturedPiece != NO_PIECE) {
+            Square capturedSquare = move.isEnPassant() ? ((us == WHITE) ? to - 8 : to + 8) : to;
+            putPiece(capturedSquare, typeOf(st.capturedPiece), colorOf(st.capturedPiece));
+        }
+    }
+    
+    castlingRights = st.castlingRights;
+    enPassantSquare = st.enPassantSquare;
+    halfmoveClock = st.halfmoveClock;
+    zobristHash = st.zobristHash;
+    
+    stateStack.pop();
+}
+
+void Position::doNullMove() {
+    assert(!isInCheck());
+    stateStack.push({NULL_MOVE, NO_PIECE, castlingRights, enPassantSquare,
+                     halfmoveClock, zobristHash});
+    
+    if (enPassantSquare != NO_SQUARE) {
+        zobristHash ^= zobrist.enPassantFile[fileOf(enPassantSquare)];
+        enPassantSquare = NO_SQUARE;
+    }
+    halfmoveClock++;
+    sideToMove = ~sideToMove;
+    zobristHash ^= zobrist.sideToMove;
+    
+    assert(zobristHash == computeHash());
+}
+
+void Position::undoNullMove() {
+    assert(!stateStack.empty() && stateStack.back().move.isNull());
+    const StateInfo& st = stateStack.back();
+    
+    sideToMove = ~sideToMove;
+    enPassantSquare = st.enPassantSquare;
+    halfmoveClock = st.halfmoveClock;
+    zobristHash = st.zobristHash;
+    
+    stateStack.pop();
+}
+
+bool Position::givesCheck(const Move& move) const {
+    Color us = sideToMove;
+    Square from = move.from();
+    Square to = move.to();
+    Square theirKing = lsb(getPieceBitboard(KING, ~us));
+    PieceType pieceType = move.isPromotion() ? promotionPiece(move) : typeOf(getPieceAt(from));
+    
+    // Occupancy and our sliders as they will be after the move
+    Bitboard occupied = (getOccupiedBitboard() & ~squareBB(from)) | squareBB(to);
+    Bitboard diagonal = (getPieceBitboard(BISHOP, us) | getPieceBitboard(QUEEN, us)) & ~squareBB(from);
+    Bitboard straight = (getPieceBitboard(ROOK, us) | getPieceBitboard(QUEEN, us)) & ~squareBB(from);
+    
+    if (move.isEnPassant()) {
+        occupied &= ~squareBB((us == WHITE) ? to - 8 : to + 8);
+    } else if (move.isCastling()) {
+        Square rookFrom, rookTo;
+        castlingRookSquares(to, rookFrom, rookTo);
+        occupied = (occupied & ~squareBB(rookFrom)) | squareBB(rookTo);
+        straight = (straight & ~squareBB(rookFrom)) | squareBB(rookTo);
+    }
+    
+    // Direct checks from the destination square
+    switch (pieceType) {
+        case PAWN:   if (pawnAttacksBB(us, to) & squareBB(theirKing)) return true; break;
+        case KNIGHT: if (knightAttacksBB(to) & squareBB(theirKing)) return true; break;
+        case BISHOP: diagonal |= squareBB(to); break;
+        case ROOK:   straight |= squareBB(to); break;
+        case QUEEN:  diagonal |= squareBB(to); straight |= squareBB(to); break;
+        default:     break;
+    }
+    
+    // Slider checks, direct or discovered
+    return (bishopAttacksBB(theirKing, occupied) & diagonal) ||
+           (rookAttacksBB(theirKing, occupied) & straight);
 }
 
 bool Position::isInCheck() const {
@@ -119,21 +240,26 @@ bool Position::isInCheck() const {
     return isSquareAttacked(kingSquare, ~sideToMove);
 }
 
+Bitboard Position::attackersTo(Square square, Bitboard occupied) const {
+    Bitboard bishopsQueens = pieceBitboards[WHITE][BISHOP] | pieceBitboards[BLACK][BISHOP] |
+                             pieceBitboards[WHITE][QUEEN] | pieceBitboards[BLACK][QUEEN];
+    Bitboard rooksQueens = pieceBitboards[WHITE][ROOK] | pieceBitboards[BLACK][ROOK] |
+                           pieceBitboards[WHITE][QUEEN] | pieceBitboards[BLACK][QUEEN];
+    
+    return (pawnAttacksBB(BLACK, square) & pieceBitboards[WHITE][PAWN]) |
+           (pawnAttacksBB(WHITE, square) & pieceBitboards[BLACK][PAWN]) |
+           (knightAttacksBB(square) & (pieceBitboards[WHITE][KNIGHT] | pieceBitboards[BLACK][KNIGHT])) |
+           (kingAttacksBB(square) & (pieceBitboards[WHITE][KING] | pieceBitboards[BLACK][KING])) |
+           (bishopAttacksBB(square, occupied) & bishopsQueens) |
+           (rookAttacksBB(square, occupied) & rooksQueens);
+}
+
 bool Position::isSquareAttacked(Square square, Color byColor) const {
     Bitboard occupied = getOccupiedBitboard();
     
-    // Check pawn attacks
-    Bitboard enemyPawns = getPieceBitboard(PAWN, byColor);
-    if (byColor == WHITE) {
-        if ((shift<Direction::SOUTH_WEST>(squareBB(square)) | 
-             shift<Direction::SOUTH_EAST>(squareBB(square))) & enemyPawns) {
-            return true;
-        }
-    } else {
-        if ((shift<Direction::NORTH_WEST>(squareBB(square)) | 
-             shift<Direction::NORTH_EAST>(squareBB(square))) & enemyPawns) {
-            return true;
-        }
+    // Check pawn attacks (reverse lookup from the target square)
+    if (pawnAttacksBB(~byColor, square) & getPieceBitboard(PAWN, byColor)) {
+        return true;
     }
     
     // Check knight attacks
@@ -163,10 +289,4 @@ bool Position::isSquareAttacked(Square square, Color byColor) const {
     return false;
 }
 
-void Position::updateHash(const Move& move) {
-    // TODO: Implement zobrist hashing
-    // For now, just increment to ensure different positions have different hashes
-    zobristHash++;
-}
-
 } // namespace chess 
\ No newline at end of file
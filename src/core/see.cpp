@@ -0,0 +1,128 @@
+#include "chess_analyzer/core/see.h"
+#include "chess_analyzer/core/bitboard_attacks.h"
+#include "chess_analyzer/core/piece_square_tables.h"
+#include <algorithm>
+
+namespace chess {
+
+namespace {
+    // Exchange values indexed by PieceType; the king's is high enough that
+    // capturing with it into a defended square never pays off
+    constexpr int SEE_VALUES[6] = {
+        PieceValue::PAWN, PieceValue::KNIGHT, PieceValue::BISHOP,
+        PieceValue::ROOK, PieceValue::QUEEN, PieceValue::KING
+    };
+    
+    // Longest possible exchange: every piece on the board takes part
+    constexpr int MAX_EXCHANGES = 32;
+    
+    PieceType promotionPiece(const Move& move) {
+        switch (move.promotionType()) {
+            case PROMOTE_TO_QUEEN:  return QUEEN;
+            case PROMOTE_TO_ROOK:   return ROOK;
+            case PROMOTE_TO_BISHOP: return BISHOP;
+            case PROMOTE_TO_KNIGHT: return KNIGHT;
+        }
+        return QUEEN;
+    }
+    
+    // Least valuable piece of a color among the attackers, NO_SQUARE if none
+    Square leastValuableAttacker(const Position& pos, Bitboard attackers, Color side,
+                                 PieceType& type) {
+        for (int pt = PAWN; pt <= KING; ++pt) {
+            Bitboard candidates = attackers & pos.getPieceBitboard(static_cast<PieceType>(pt), side);
+            if (candidates) {
+                type = static_cast<PieceType>(pt);
+                return lsb(candidates);
+            }
+        }
+        return NO_SQUARE;
+    }
+}
+
+int staticExchange(const Position& pos, const Move& move) {
+    if (move.isCastling()) {
+        return 0;
+    }
+    
+    Square from = move.from();
+    Square to = move.to();
+    Color us = pos.getSideToMove();
+    
+    Bitboard occupied = pos.getOccupiedBitboard() ^ squareBB(from);
+    PieceType onSquare = typeOf(pos.getPieceAt(from));
+    
+    // gain[d]: material balance for the side making capture d, assuming
+    // the exchange stops right after it
+    int gain[MAX_EXCHANGES];
+    if (move.isEnPassant()) {
+        gain[0] = SEE_VALUES[PAWN];
+        occupied ^= squareBB((us == WHITE) ? to - 8 : to + 8);
+    } else {
+        Piece captured = pos.getPieceAt(to);
+        gain[0] = (captured != NO_PIECE) ? SEE_VALUES[typeOf(captured)] : 0;
+    }
+    if (move.isPromotion()) {
+        onSquare = promotionPiece(move);
+        gain[0] += SEE_VALUES[onSquare] - SEE_VALUES[PAWN];
+    }
+    
+    Bitboard bishopsQueens = pos.getPieceBitboard(BISHOP, WHITE) | pos.getPieceBitboard(BISHOP, BLACK) |
+                             pos.getPieceBitboard(QUEEN, WHITE) | pos.getPieceBitboard(QUEEN, BLACK);
+    Bitboard rooksQueens = pos.getPieceBitboard(ROOK, WHITE) | pos.getPieceBitboard(ROOK, BLACK) |
+                           pos.getPieceBitboard(QUEEN, WHITE) | pos.getPieceBitboard(QUEEN, BLACK);
+    Bitboard attackers = pos.attackersTo(to, occupied) & occupied;
+    Color side = ~us;
+    int depth = 0;
+    
+    while (depth + 1 < MAX_EXCHANGES) {
+        PieceType attackerType;
+        Square attacker = leastValuableAttacker(pos, attackers, side, attackerType);
+        if (attacker == NO_SQUARE) {
+            break;
+        }
+        
+        ++depth;
+        gain[depth] = SEE_VALUES[onSquare] - gain[depth - 1];
+        
+        // Neither side can do better by continuing than by stopping here
+        if (std::max(-gain[depth - 1], gain[depth]) < 0) {
+            break;
+        }
+        
+        // Moving the attacker off its square may uncover a slider behind it
+        occupied ^= squareBB(attacker);
+        if (attackerType == PAWN || attackerType == BISHOP || attackerType == QUEEN) {
+            attackers |= bishopAttacksBB(to, occupied) & bishopsQueens;
+        }
+        if (attackerType == ROOK || attackerType == QUEEN) {
+            attackers |= rookAttacksBB(to, occupied) & rooksQueens;
+        }
+        attackers &= occupied;
+        
+        onSquare = attackerType;
+        side = ~side;
+    }
+    
+    // Each side may stop the exchange instead of recapturing
+    while (depth > 0) {
+        gain[depth - 1] = -std::max(-gain[depth - 1], gain[depth]);
+        --depth;
+    }
+    return gain[0];
+}
+
+bool staticExchangeAtLeast(const Position& pos, const Move& move, int threshold) {
+    // Taking a piece worth at least as much as the capturer can lose it at
+    // most, so the exchange gains no less than the difference
+    if (threshold <= 0 && !move.isPromotion() && !move.isCastling()) {
+        Piece captured = move.isEnPassant() ? makePiece(~pos.getSideToMove(), PAWN) : pos.getPieceAt(move.to());
+        if (captured != NO_PIECE &&
+            SEE_VALUES[typeOf(captured)] - SEE_VALUES[typeOf(pos.getPieceAt(move.from()))] >= threshold) {
+            return true;
+        }
+    }
+    return staticExchange(pos, move) >= threshold;
+}
+
+} // namespace chess
\ No newline at end of file
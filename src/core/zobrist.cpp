@@ -0,0 +1,52 @@
+#include "chess_analyzer/core/zobrist.h"
+
+namespace chess {
+
+namespace {
+    // splitmix64 - good avalanche, usable in constant expressions
+    constexpr uint64_t nextKey(uint64_t& state) {
+        uint64_t z = (state += 0x9E3779B97F4A7C15ULL);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        return z ^ (z >> 31);
+    }
+    
+    constexpr ZobristKeys generateKeys() {
+        ZobristKeys keys{};
+        uint64_t state = 0x2545F4914F6CDD1DULL;
+        
+        for (int c = 0; c < 2; ++c) {
+            for (int pt = 0; pt < 6; ++pt) {
+                for (int sq = 0; sq < 64; ++sq) {
+                    keys.pieceSquare[c][pt][sq] = nextKey(state);
+                }
+            }
+        }
+        
+        keys.sideToMove = nextKey(state);
+        
+        // One key per right; combinations are the XOR of their rights so
+        // losing a single right is one table lookup
+        uint64_t rightKeys[4] = {nextKey(state), nextKey(state), nextKey(state), nextKey(state)};
+        for (int rights = 0; rights < 16; ++rights) {
+            keys.castling[rights] = 0;
+            for (int bit = 0; bit < 4; ++bit) {
+                if (rights & (1 << bit)) {
+                    keys.castling[rights] ^= rightKeys[bit];
+                }
+            }
+        }
+        
+        for (int file = 0; file < 8; ++file) {
+            keys.enPassantFile[file] = nextKey(state);
+        }
+        
+        return keys;
+    }
+}
+
+// constexpr initialization avoids any static initialization order issues
+// with positions constructed during startup
+constexpr ZobristKeys zobrist = generateKeys();
+
+} // namespace chess
\ No newline at end of file
@@ -6,120 +6,36 @@
 
 namespace chess {
 
-// Piece-square tables for positional evaluation
 namespace {
-    // Pawn positional values (from white's perspective)
-    constexpr int pawnTable[64] = {
-         0,  0,  0,  0,  0,  0,  0,  0,
-        50, 50, 50, 50, 50, 50, 50, 50,
-        10, 10, 20, 30, 30, 20, 10, 10,
-         5,  5, 10, 25, 25, 10,  5,  5,
-         0,  0,  0, 20, 20,  0,  0,  0,
-         5, -5,-10,  0,  0,-10, -5,  5,
-         5, 10, 10,-20,-20, 10, 10,  5,
-         0,  0,  0,  0,  0,  0,  0,  0
-    };
+    // Evaluation weights as middlegame/endgame pairs
+    constexpr Score DOUBLED_PAWN = makeScore(-10, -20);
+    constexpr Score ISOLATED_PAWN = makeScore(-15, -20);
+    constexpr Score KNIGHT_MOBILITY = makeScore(4, 4);
+    constexpr Score BISHOP_MOBILITY = makeScore(3, 4);
+    constexpr Score PAWN_SHIELD = makeScore(10, 0);       // King shelter only matters
+    constexpr Score OPEN_KING_FILE = makeScore(-20, 0);   // while attackers remain
+    constexpr Score CENTER_ATTACK = makeScore(10, 5);
+    constexpr Score CENTER_OCCUPATION = makeScore(15, 5);
     
-    // Knight positional values
-    constexpr int knightTable[64] = {
-        -50,-40,-30,-30,-30,-30,-40,-50,
-        -40,-20,  0,  0,  0,  0,-20,-40,
-        -30,  0, 10, 15, 15, 10,  0,-30,
-        -30,  5, 15, 20, 20, 15,  5,-30,
-        -30,  0, 15, 20, 20, 15,  0,-30,
-        -30,  5, 10, 15, 15, 10,  5,-30,
-        -40,-20,  0,  5,  5,  0,-20,-40,
-        -50,-40,-30,-30,-30,-30,-40,-50
-    };
-    
-    // Bishop positional values
-    constexpr int bishopTable[64] = {
-        -20,-10,-10,-10,-10,-10,-10,-20,
-        -10,  0,  0,  0,  0,  0,  0,-10,
-        -10,  0,  5, 10, 10,  5,  0,-10,
-        -10,  5,  5, 10, 10,  5,  5,-10,
-        -10,  0, 10, 10, 10, 10,  0,-10,
-        -10, 10, 10, 10, 10, 10, 10,-10,
-        -10,  5,  0,  0,  0,  0,  5,-10,
-        -20,-10,-10,-10,-10,-10,-10,-20
-    };
-    
-    // Rook positional values
-    constexpr int rookTable[64] = {
-         0,  0,  0,  0,  0,  0,  0,  0,
-         5, 10, 10, 10, 10, 10, 10,  5,
-        -5,  0,  0,  0,  0,  0,  0, -5,
-        -5,  0,  0,  0,  0,  0,  0, -5,
-        -5,  0,  0,  0,  0,  0,  0, -5,
-        -5,  0,  0,  0,  0,  0,  0, -5,
-        -5,  0,  0,  0,  0,  0,  0, -5,
-         0,  0,  0,  5,  5,  0,  0,  0
-    };
-    
-    // Queen positional values
-    constexpr int queenTable[64] = {
-        -20,-10,-10, -5, -5,-10,-10,-20,
-        -10,  0,  0,  0,  0,  0,  0,-10,
-        -10,  0,  5,  5,  5,  5,  0,-10,
-         -5,  0,  5,  5,  5,  5,  0, -5,
-          0,  0,  5,  5,  5,  5,  0, -5,
-        -10,  5,  5,  5,  5,  5,  0,-10,
-        -10,  0,  5,  0,  0,  0,  0,-10,
-        -20,-10,-10, -5, -5,-10,-10,-20
-    };
-    
-    // King positional values (middlegame)
-    constexpr int kingMiddlegameTable[64] = {
-        -30,-40,-40,-50,-50,-40,-40,-30,
-        -30,-40,-40,-50,-50,-40,-40,-30,
-        -30,-40,-40,-50,-50,-40,-40,-30,
-        -30,-40,-40,-50,-50,-40,-40,-30,
-        -20,-30,-30,-40,-40,-30,-30,-20,
-        -10,-20,-20,-20,-20,-20,-20,-10,
-         20, 20,  0,  0,  0,  0, 20, 20,
-         20, 30, 10,  0,  0, 10, 30, 20
-    };
-    
-    // King positional values (endgame)
-    constexpr int kingEndgameTable[64] = {
-        -50,-40,-30,-20,-20,-30,-40,-50,
-        -30,-20,-10,  0,  0,-10,-20,-30,
-        -30,-10, 20, 30, 30, 20,-10,-30,
-        -30,-10, 30, 40, 40, 30,-10,-30,
-        -30,-10, 30, 40, 40, 30,-10,-30,
-        -30,-10, 20, 30, 30, 20,-10,-30,
-        -30,-30,  0,  0,  0,  0,-30,-30,
-        -50,-30,-30,-30,-30,-30,-30,-50
-    };
+    // Passed pawns grow in value as they advance, and even more so once
+    // the pieces that could stop them are gone
+    Score passedPawnBonus(int rank) {
+        int bonus = 10 + rank * rank * 5;
+        return makeScore(bonus, bonus * 3 / 2);
+    }
     
-    int getPieceSquareValue(PieceType piece, Square sq, Color color, bool endgame) {
-        // Flip square for black pieces
-        if (color == BLACK) {
-            sq = sq ^ 56;  // Flip vertically
-        }
-        
-        switch (piece) {
-            case PAWN:   return pawnTable[sq];
-            case KNIGHT: return knightTable[sq];
-            case BISHOP: return bishopTable[sq];
-            case ROOK:   return rookTable[sq];
-            case QUEEN:  return queenTable[sq];
-            case KING:   return endgame ? kingEndgameTable[sq] : kingMiddlegameTable[sq];
-            default:     return 0;
-        }
+    // Blend the two phases by the material left on the board
+    int taper(Score score, int phase) {
+        phase = std::min(phase, MAX_PHASE);
+        return (mgValue(score) * phase + egValue(score) * (MAX_PHASE - phase)) / MAX_PHASE;
     }
 }
 
 class Evaluator::Impl {
 public:
     int evaluate(const Position& pos) const {
-        int score = 0;
-        
-        // Material balance
-        score += getMaterialBalance(pos);
-        
-        // Piece-square tables
-        score += getPieceSquareScore(pos);
+        // Material and piece-square tables, kept up to date by the position
+        Score score = makeScore(pos.getMaterial(), pos.getMaterial()) + pos.getPsqt();
         
         // Pawn structure
         score += evaluatePawnStructure(pos);
@@ -133,51 +49,17 @@ public:
         // Center control
         score += evaluateCenterControl(pos);
         
-        // Return score from perspective of side to move
-        return pos.getSideToMove() == WHITE ? score : -score;
+        // Interpolate once, then return from perspective of side to move
+        int value = taper(score, pos.getGamePhase());
+        return pos.getSideToMove() == WHITE ? value : -value;
     }
     
     int getMaterialBalance(const Position& pos) const {
-        int material = 0;
-        
-        // Count material for each piece type
-        material += (popcount(pos.getPieceBitboard(PAWN, WHITE)) - 
-                    popcount(pos.getPieceBitboard(PAWN, BLACK))) * PieceValue::PAWN;
-        material += (popcount(pos.getPieceBitboard(KNIGHT, WHITE)) - 
-                    popcount(pos.getPieceBitboard(KNIGHT, BLACK))) * PieceValue::KNIGHT;
-        material += (popcount(pos.getPieceBitboard(BISHOP, WHITE)) - 
-                    popcount(pos.getPieceBitboard(BISHOP, BLACK))) * PieceValue::BISHOP;
-        material += (popcount(pos.getPieceBitboard(ROOK, WHITE)) - 
-                    popcount(pos.getPieceBitboard(ROOK, BLACK))) * PieceValue::ROOK;
-        material += (popcount(pos.getPieceBitboard(QUEEN, WHITE)) - 
-                    popcount(pos.getPieceBitboard(QUEEN, BLACK))) * PieceValue::QUEEN;
-        
-        return material;
-    }
-    
-    int getPieceSquareScore(const Position& pos) const {
-        int score = 0;
-        bool endgame = isEndgame(pos);
-        
-        for (Color c : {WHITE, BLACK}) {
-            int colorScore = 0;
-            
-            for (PieceType pt = PAWN; pt <= KING; pt = static_cast<PieceType>(pt + 1)) {
-                Bitboard pieces = pos.getPieceBitboard(pt, c);
-                while (pieces) {
-                    Square sq = popLsb(pieces);
-                    colorScore += getPieceSquareValue(pt, sq, c, endgame);
-                }
-            }
-            
-            score += (c == WHITE) ? colorScore : -colorScore;
-        }
-        
-        return score;
+        return pos.getMaterial();
     }
     
-    int evaluatePawnStructure(const Position& pos) const {
-        int score = 0;
+    Score evaluatePawnStructure(const Position& pos) const {
+        Score score = SCORE_ZERO;
         
         Bitboard whitePawns = pos.getPieceBitboard(PAWN, WHITE);
         Bitboard blackPawns = pos.getPieceBitboard(PAWN, BLACK);
@@ -188,8 +70,8 @@ public:
             int whitePawnsOnFile = popcount(whitePawns & fileMask);
             int blackPawnsOnFile = popcount(blackPawns & fileMask);
             
-            if (whitePawnsOnFile > 1) score -= 10 * (whitePawnsOnFile - 1);
-            if (blackPawnsOnFile > 1) score += 10 * (blackPawnsOnFile - 1);
+            if (whitePawnsOnFile > 1) score += DOUBLED_PAWN * (whitePawnsOnFile - 1);
+            if (blackPawnsOnFile > 1) score -= DOUBLED_PAWN * (blackPawnsOnFile - 1);
         }
         
         // Isolated pawns penalty
@@ -200,10 +82,10 @@ public:
             if (file < 7) adjacentFiles |= FILE_A << (file + 1);
             
             if ((whitePawns & fileMask) && !(whitePawns & adjacentFiles)) {
-                score -= 15;  // Isolated pawn penalty
+                score += ISOLATED_PAWN;
             }
             if ((blackPawns & fileMask) && !(blackPawns & adjacentFiles)) {
-                score += 15;
+                score -= ISOLATED_PAWN;
             }
         }
         
@@ -214,22 +96,22 @@ public:
         while (whitePassed) {
             Square sq = popLsb(whitePassed);
             int rank = rankOf(sq);
-            score += 10 + rank * rank * 5;  // Bonus increases with advancement
+            score += passedPawnBonus(rank);
         }
         
         while (blackPassed) {
             Square sq = popLsb(blackPassed);
             int rank = 7 - rankOf(sq);
-            score -= 10 + rank * rank * 5;
+            score -= passedPawnBonus(rank);
         }
         
         return score;
     }
     
-    int evaluateMobility(const Position& pos) const {
+    Score evaluateMobility(const Position& pos) const {
         // Simplified mobility evaluation
         // Count number of squares each piece can move to
-        int score = 0;
+        Score score = SCORE_ZERO;
         Bitboard occupied = pos.getOccupiedBitboard();
         
         // Knight mobility
@@ -238,12 +120,12 @@ public:
         
         while (whiteKnights) {
             Square sq = popLsb(whiteKnights);
-            score += popcount(knightAttacksBB(sq) & ~pos.getColorBitboard(WHITE)) * 4;
+            score += KNIGHT_MOBILITY * popcount(knightAttacksBB(sq) & ~pos.getColorBitboard(WHITE));
         }
         
         while (blackKnights) {
             Square sq = popLsb(blackKnights);
-            score -= popcount(knightAttacksBB(sq) & ~pos.getColorBitboard(BLACK)) * 4;
+            score -= KNIGHT_MOBILITY * popcount(knightAttacksBB(sq) & ~pos.getColorBitboard(BLACK));
         }
         
         // Bishop mobility
@@ -252,20 +134,20 @@ public:
         
         while (whiteBishops) {
             Square sq = popLsb(whiteBishops);
-            score += popcount(bishopAttacksBB(sq, occupied) & ~pos.getColorBitboard(WHITE)) * 3;
+            score += BISHOP_MOBILITY * popcount(bishopAttacksBB(sq, occupied) & ~pos.getColorBitboard(WHITE));
         }
         
         while (blackBishops) {
             Square sq = popLsb(blackBishops);
-            score -= popcount(bishopAttacksBB(sq, occupied) & ~pos.getColorBitboard(BLACK)) * 3;
+            score -= BISHOP_MOBILITY * popcount(bishopAttacksBB(sq, occupied) & ~pos.getColorBitboard(BLACK));
         }
         
         return score;
     }
     
-    int evaluateKingSafety(const Position& pos, Color color) const {
+    Score evaluateKingSafety(const Position& pos, Color color) const {
         Square kingSquare = lsb(pos.getPieceBitboard(KING, color));
-        int safety = 0;
+        Score safety = SCORE_ZERO;
         
         // Penalty for exposed king
         Bitboard kingZone = kingAttacksBB(kingSquare);
@@ -273,22 +155,22 @@ public:
         
         // Count pawn shield
         int pawnShield = popcount(kingZone & ourPawns);
-        safety += pawnShield * 10;
+        safety += PAWN_SHIELD * pawnShield;
         
         // Penalty for open files near king
         int kingFile = fileOf(kingSquare);
         for (int f = std::max(0, kingFile - 1); f <= std::min(7, kingFile + 1); ++f) {
             Bitboard fileMask = FILE_A << f;
             if (!(ourPawns & fileMask)) {
-                safety -= 20;  // Open file penalty
+                safety += OPEN_KING_FILE;
             }
         }
         
         return safety;
     }
     
-    int evaluateCenterControl(const Position& pos) const {
-        int score = 0;
+    Score evaluateCenterControl(const Position& pos) const {
+        Score score = SCORE_ZERO;
         
         // Control of center squares
         Bitboard whiteControl = 0;
@@ -306,14 +188,14 @@ public:
             if (pos.isSquareAttacked(sq, BLACK)) blackControl |= squareBB(sq);
         }
         
-        score += popcount(whiteControl) * 10;
-        score -= popcount(blackControl) * 10;
+        score += CENTER_ATTACK * popcount(whiteControl);
+        score -= CENTER_ATTACK * popcount(blackControl);
         
         // Pieces on center squares
         Bitboard centerBitboard = squareBB(makeSquare(3, 3)) | squareBB(makeSquare(4, 3)) |
                                  squareBB(makeSquare(3, 4)) | squareBB(makeSquare(4, 4));
-        score += popcount(centerBitboard & pos.getColorBitboard(WHITE)) * 15;
-        score -= popcount(centerBitboard & pos.getColorBitboard(BLACK)) * 15;
+        score += CENTER_OCCUPATION * popcount(centerBitboard & pos.getColorBitboard(WHITE));
+        score -= CENTER_OCCUPATION * popcount(centerBitboard & pos.getColorBitboard(BLACK));
         
         return score;
     }
@@ -377,19 +259,19 @@ int Evaluator::getMaterialBalance(const Position& position) const {
 }
 
 int Evaluator::evaluatePawnStructure(const Position& position) const {
-    return pImpl->evaluatePawnStructure(position);
+    return taper(pImpl->evaluatePawnStructure(position), position.getGamePhase());
 }
 
 int Evaluator::evaluateKingSafety(const Position& position, Color color) const {
-    return pImpl->evaluateKingSafety(position, color);
+    return taper(pImpl->evaluateKingSafety(position, color), position.getGamePhase());
 }
 
 int Evaluator::evaluateMobility(const Position& position) const {
-    return pImpl->evaluateMobility(position);
+    return taper(pImpl->evaluateMobility(position), position.getGamePhase());
 }
 
 int Evaluator::evaluateCenterControl(const Position& position) const {
-    return pImpl->evaluateCenterControl(position);
+    return taper(pImpl->evaluateCenterControl(position), position.getGamePhase());
 }
 
 bool Evaluator::isEndgame(const Position& position) const {
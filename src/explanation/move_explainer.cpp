@@ -1,5 +1,6 @@
 #include "chess_analyzer/explanation/move_explainer.h"
 #include "chess_analyzer/core/move_generator.h"
+#include "chess_analyzer/core/see.h"
 #include <sstream>
 #include <memory>
 #include <algorithm>
@@ -110,8 +111,7 @@ std::string MoveExplainer::Impl::analyzeTactics(const Position& pos, const Move&
     std::ostringstream tactics;
     
     // Check if move gives check
-    Position afterMove = pos.makeMove(move);
-    if (afterMove.isInCheck()) {
+    if (pos.givesCheck(move)) {
         tactics << "This move gives check";
         
         // TODO: Check for checkmate patterns
@@ -120,6 +120,21 @@ std::string MoveExplainer::Impl::analyzeTactics(const Position& pos, const Move&
         // }
     }
     
+    // Static exchange on the target square: does the capture hold up
+    // once the opponent recaptures?
+    if (pos.getPieceAt(move.to()) != NO_PIECE || move.isEnPassant()) {
+        int exchange = staticExchange(pos, move);
+        if (exchange < 0) {
+            if (tactics.tellp() > 0) {
+                tactics << ", but ";
+            } else {
+                tactics << "However, ";
+            }
+            tactics << "this capture loses material after the recaptures on "
+                    << squareToString(move.to());
+        }
+    }
+    
     // TODO: Implement tactical pattern recognition
     // - Forks
     // - Pins
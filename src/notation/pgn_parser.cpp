@@ -76,7 +76,7 @@ public:
             Move move = parseAlgebraicMoveImpl(pos, token);
             if (!move.isNull()) {
                 moves.push_back(move);
-                pos = pos.makeMove(move);
+                pos.doMove(move);
             } else {
                 lastError = "Invalid move: " + token;
                 break;
@@ -311,7 +311,7 @@ std::string PGNParser::gameToPGN(const Game& game) const {
         }
         
         pgn << moveToAlgebraic(pos, game.moves[i]) << " ";
-        pos = pos.makeMove(game.moves[i]);
+        pos.doMove(game.moves[i]);
         
         if ((i + 1) % 2 == 0 && i + 1 < game.moves.size()) {
             pgn << "\n";
@@ -0,0 +1,85 @@
+#include "chess_analyzer/search/move_ordering.h"
+#include "chess_analyzer/core/see.h"
+#include "chess_analyzer/core/piece_square_tables.h"
+#include <algorithm>
+
+namespace chess {
+
+namespace {
+    // Piece values indexed by PieceType; kings are never captured
+    constexpr int PIECE_VALUES[6] = {
+        PieceValue::PAWN, PieceValue::KNIGHT, PieceValue::BISHOP,
+        PieceValue::ROOK, PieceValue::QUEEN, 0
+    };
+}
+
+int captureGain(const Position& pos, const Move& move) {
+    int gain = 0;
+    if (move.isEnPassant()) {
+        gain = PIECE_VALUES[PAWN];
+    } else if (pos.getPieceAt(move.to()) != NO_PIECE) {
+        gain = PIECE_VALUES[typeOf(pos.getPieceAt(move.to()))];
+    }
+    if (move.isPromotion()) {
+        gain += PIECE_VALUES[QUEEN] - PIECE_VALUES[PAWN];
+    }
+    return gain;
+}
+
+int mvvLva(const Position& pos, const Move& move) {
+    return captureGain(pos, move) * 8 - typeOf(pos.getPieceAt(move.from()));
+}
+
+bool isTactical(const Position& pos, const Move& move) {
+    return pos.getPieceAt(move.to()) != NO_PIECE || move.isEnPassant() ||
+           (move.isPromotion() && move.promotionType() == PROMOTE_TO_QUEEN);
+}
+
+MoveOrdering::MoveOrdering() {
+    clear();
+}
+
+void MoveOrdering::clear() {
+    std::fill(&killers[0][0], &killers[0][0] + (MAX_PLY + 1) * 2, NULL_MOVE);
+    std::fill(&history[0][0][0], &history[0][0][0] + 2 * 64 * 64, 0);
+}
+
+void MoveOrdering::scoreMoves(const Position& pos, MoveList& moves, Move hashMove, int ply) const {
+    const int (&sideHistory)[64][64] = history[pos.getSideToMove()];
+    for (size_t i = 0; i < moves.size(); ++i) {
+        Move move = moves[i];
+        if (move == hashMove) {
+            moves.score(i) = HASH_MOVE_SCORE;
+        } else if (isTactical(pos, move)) {
+            moves.score(i) = (staticExchangeAtLeast(pos, move, 0) ? CAPTURE_SCORE : LOSING_CAPTURE_SCORE)
+                           + mvvLva(pos, move);
+        } else if (move == killers[ply][0]) {
+            moves.score(i) = KILLER_SCORE + 1;
+        } else if (move == killers[ply][1]) {
+            moves.score(i) = KILLER_SCORE;
+        } else {
+            moves.score(i) = sideHistory[move.from()][move.to()];
+        }
+    }
+}
+
+void MoveOrdering::updateQuietStats(const Position& pos, Move move, int depth, int ply) {
+    if (killers[ply][0] != move) {
+        killers[ply][1] = killers[ply][0];
+        killers[ply][0] = move;
+    }
+    
+    int& entry = history[pos.getSideToMove()][move.from()][move.to()];
+    entry += depth * depth;
+    if (entry >= HISTORY_MAX) {
+        for (auto& side : history) {
+            for (auto& from : side) {
+                for (int& value : from) {
+                    value /= 2;
+                }
+            }
+        }
+    }
+}
+
+} // namespace chess
\ No newline at end of file
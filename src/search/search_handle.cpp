@@ -0,0 +1,95 @@
+#include "chess_analyzer/search/search_handle.h"
+#include <chrono>
+#include <mutex>
+#include <utility>
+
+namespace chess {
+
+// Shared by the handle and the worker thread, so neither outlives it
+struct SearchHandle::State {
+    std::atomic<bool> stopRequested{false};
+    
+    mutable std::mutex progressMutex;
+    SearchResult latest;
+    
+    std::promise<SearchResult> promise;
+    std::shared_future<SearchResult> result;
+};
+
+SearchHandle::SearchHandle() = default;
+
+SearchHandle::~SearchHandle() {
+    finish();
+}
+
+SearchHandle::SearchHandle(SearchHandle&& other) noexcept
+    : state(std::move(other.state)), worker(std::move(other.worker)) {}
+
+SearchHandle& SearchHandle::operator=(SearchHandle&& other) noexcept {
+    if (this != &other) {
+        finish();
+        state = std::move(other.state);
+        worker = std::move(other.worker);
+    }
+    return *this;
+}
+
+SearchHandle SearchHandle::launch(Job job) {
+    SearchHandle handle;
+    handle.state = std::make_shared<State>();
+    handle.state->result = handle.state->promise.get_future().share();
+    
+    std::shared_ptr<State> state = handle.state;
+    handle.worker = std::thread([state, job = std::move(job)] {
+        auto onProgress = [&state](const SearchResult& result) {
+            std::lock_guard<std::mutex> lock(state->progressMutex);
+            state->latest = result;
+        };
+        
+        try {
+            SearchResult result = job(state->stopRequested, onProgress);
+            onProgress(result);
+            state->promise.set_value(std::move(result));
+        } catch (...) {
+            state->promise.set_exception(std::current_exception());
+        }
+    });
+    return handle;
+}
+
+SearchResult SearchHandle::progress() const {
+    if (!state) {
+        return SearchResult();
+    }
+    std::lock_guard<std::mutex> lock(state->progressMutex);
+    return state->latest;
+}
+
+void SearchHandle::stop() {
+    if (state) {
+        state->stopRequested = true;
+    }
+}
+
+bool SearchHandle::isFinished() const {
+    // Ready only once the promise is set, so the result can be read at once
+    return state && state->result.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+}
+
+SearchResult SearchHandle::wait() const {
+    return state ? state->result.get() : SearchResult();
+}
+
+std::shared_future<SearchResult> SearchHandle::future() const {
+    return state ? state->result : std::shared_future<SearchResult>();
+}
+
+void SearchHandle::finish() {
+    stop();
+    if (worker.joinable()) {
+        worker.join();
+    }
+    state.reset();
+}
+
+} // namespace chess
\ No newline at end of file
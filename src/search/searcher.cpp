@@ -0,0 +1,587 @@
+#include "chess_analyzer/search/searcher.h"
+#include "chess_analyzer/core/move_generator.h"
+#include "chess_analyzer/core/move_list.h"
+#include "chess_analyzer/core/see.h"
+#include "chess_analyzer/search/move_ordering.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <utility>
+
+namespace chess {
+
+namespace {
+    // How often (in nodes) the clock and stop flag are checked
+    constexpr uint64_t CHECK_INTERVAL = 2048;
+    
+    // Mate scores count plies from the root; the table stores them relative
+    // to the node so they stay valid when reached by a different path
+    int scoreToTT(int score, int ply) {
+        if (score >= MATE_IN_MAX_PLY) return score + ply;
+        if (score <= -MATE_IN_MAX_PLY) return score - ply;
+        return score;
+    }
+    
+    int scoreFromTT(int score, int ply) {
+        if (score >= MATE_IN_MAX_PLY) return score - ply;
+        if (score <= -MATE_IN_MAX_PLY) return score + ply;
+        return score;
+    }
+    
+    // Slack added to a capture's material gain before delta pruning gives up on it
+    constexpr int DELTA_MARGIN = 200;
+    
+    // Shallow iterations are cheap and unstable, so they use a full window
+    constexpr int ASPIRATION_MIN_DEPTH = 4;
+    
+    // Move numbers beyond this share the last row of the reduction table
+    constexpr int LMR_MAX_MOVES = 64;
+    
+    // Null-move pruning is unsafe when the side to move has nothing but
+    // pawns left: zugzwang is common there
+    bool hasNonPawnMaterial(const Position& pos) {
+        Color us = pos.getSideToMove();
+        return (pos.getPieceBitboard(KNIGHT, us) | pos.getPieceBitboard(BISHOP, us) |
+                pos.getPieceBitboard(ROOK, us) | pos.getPieceBitboard(QUEEN, us)) != 0;
+    }
+    
+    // Selection step of a lazy sort: bring the best-scored remaining move to
+    // index i, so lists cut off early are never fully sorted
+    void pickBest(MoveList& moves, size_t i) {
+        size_t best = i;
+        for (size_t j = i + 1; j < moves.size(); ++j) {
+            if (moves.score(j) > moves.score(best)) {
+                best = j;
+            }
+        }
+        if (best != i) {
+            moves.swap(i, best);
+        }
+    }
+    
+    // Lazy SMP depth staggering: helper threads skip some iterations so
+    // they spread over neighbouring depths instead of duplicating the main
+    // thread's work. Helper i uses pattern (i - 1) % SKIP_PATTERNS.
+    constexpr int SKIP_PATTERNS = 20;
+    constexpr int SKIP_SIZE[SKIP_PATTERNS]  = {1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 3, 3, 4, 4, 4, 4, 4, 4, 4, 4};
+    constexpr int SKIP_PHASE[SKIP_PATTERNS] = {0, 1, 0, 1, 2, 3, 0, 1, 2, 3, 4, 5, 0, 1, 2, 3, 4, 5, 6, 7};
+    
+    bool skipsDepth(int threadIndex, int depth) {
+        if (threadIndex == 0) return false;
+        int i = (threadIndex - 1) % SKIP_PATTERNS;
+        return ((depth + SKIP_PHASE[i]) / SKIP_SIZE[i]) % 2 != 0;
+    }
+}
+
+class Searcher::Impl {
+public:
+    Impl(const Evaluator& evaluator, TranspositionTable& tt, int threadIndex)
+        : evaluator(evaluator), tt(tt), threadIndex(threadIndex) {
+        setOptions(SearchOptions());
+    }
+    
+    void setOptions(const SearchOptions& searchOptions) {
+        options = searchOptions;
+        for (int depth = 0; depth < MAX_PLY; ++depth) {
+            for (int moveNumber = 0; moveNumber < LMR_MAX_MOVES; ++moveNumber) {
+                double reduction = (depth > 0 && moveNumber > 0)
+                    ? options.lmrBase + std::log(depth) * std::log(moveNumber) / options.lmrDivisor
+                    : 0.0;
+                reductions[depth][moveNumber] = std::max(0, static_cast<int>(reduction));
+            }
+        }
+    }
+    
+    void setProgressCallback(SearchProgressCallback callback) {
+        progressCallback = std::move(callback);
+    }
+    
+    void setNodeCounter(std::atomic<uint64_t>* counter) {
+        sharedNodes = counter;
+    }
+    
+    SearchResult search(const Position& position, const SearchLimits& searchLimits,
+                        const std::atomic<bool>& stopFlag) {
+        limits = searchLimits;
+        stop = &stopFlag;
+        startTime = std::chrono::steady_clock::now();
+        nodes = 0;
+        reportedNodes = 0;
+        aborted = false;
+        stats = SearchStats();
+        ordering.clear();
+        
+        Position pos = position;
+        SearchResult result;
+        
+        MoveList rootMoves;
+        moveGen.generateLegalMoves(pos, rootMoves);
+        if (rootMoves.empty()) {
+            result.score = pos.isInCheck() ? -MATE_SCORE : 0;
+            return result;
+        }
+        
+        // Something to play even if the first iteration is interrupted
+        result.bestMove = rootMoves[0];
+        result.pv = {rootMoves[0]};
+        
+        result.lines = {PVLine{rootMoves[0], 0, result.pv}};
+        
+        int maxDepth = (limits.depth > 0) ? std::min(limits.depth, MAX_PLY - 1) : MAX_PLY - 1;
+        size_t lineCount = std::min(static_cast<size_t>(std::max(limits.multiPV, 1)), rootMoves.size());
+        std::vector<PVLine> lines;
+        
+        for (int depth = 1; depth <= maxDepth; ++depth) {
+            if (skipsDepth(threadIndex, depth)) {
+                continue;
+            }
+            
+            // MultiPV: search the root once per line, each time without the
+            // moves already ranked; the table carries over from line to line
+            uint64_t iterationStartNodes = nodes;
+            int64_t iterationStartMs = elapsedMs();
+            lines.clear();
+            rootExcluded.clear();
+            for (size_t line = 0; line < lineCount; ++line) {
+                bool hasPrevious = result.depth > 0 && line < result.lines.size();
+                int score = aspirationSearch(pos, depth, hasPrevious, hasPrevious ? result.lines[line].score : 0);
+                if (aborted) {
+                    break;
+                }
+                
+                lines.push_back({pvTable[0][0], score, std::vector<Move>(pvTable[0], pvTable[0] + pvLength[0])});
+                rootExcluded.push_back(pvTable[0][0]);
+            }
+            
+            if (aborted) {
+                break;
+            }
+            
+            // Later lines can come out slightly better than earlier ones
+            // when the search is unstable
+            std::stable_sort(lines.begin(), lines.end(), [](const PVLine& a, const PVLine& b) {
+                return a.score > b.score;
+            });
+            
+            result.lines = lines;
+            result.bestMove = lines[0].move;
+            result.pv = lines[0].pv;
+            result.score = lines[0].score;
+            result.depth = depth;
+            stats.iterations.push_back({depth, nodes - iterationStartNodes, elapsedMs() - iterationStartMs});
+            
+            if (progressCallback) {
+                result.nodes = nodes;
+                result.timeMs = elapsedMs();
+                result.stats = currentStats(result.timeMs);
+                progressCallback(result);
+            }
+            
+            // A forced mate within the searched depth will not change
+            if (lineCount == 1 && isMateScore(result.score) && MATE_SCORE - std::abs(result.score) <= depth) {
+                break;
+            }
+            
+            // The next iteration takes several times longer than this one,
+            // so don't start it if it would most likely be cut off
+            if (limits.timeMs > 0 && elapsedMs() * 2 > limits.timeMs) {
+                break;
+            }
+        }
+        
+        result.nodes = nodes;
+        result.timeMs = elapsedMs();
+        result.stats = currentStats(result.timeMs);
+        return result;
+    }
+
+private:
+    const Evaluator& evaluator;
+    TranspositionTable& tt;
+    int threadIndex;
+    MoveGenerator moveGen;
+    SearchOptions options;
+    SearchProgressCallback progressCallback;
+    
+    // Late move reductions by remaining depth and move number, from options
+    int reductions[MAX_PLY][LMR_MAX_MOVES];
+    
+    SearchLimits limits;
+    const std::atomic<bool>* stop = nullptr;
+    std::chrono::steady_clock::time_point startTime;
+    uint64_t nodes = 0;
+    bool aborted = false;
+    
+    // Node total of all searchers sharing the limit, and how much of this
+    // searcher's count has been added to it
+    std::atomic<uint64_t>* sharedNodes = nullptr;
+    uint64_t reportedNodes = 0;
+    SearchStats stats;
+    
+    // Root moves already ranked in this MultiPV iteration
+    MoveList rootExcluded;
+    
+    // Killers and history for quiet moves
+    MoveOrdering ordering;
+    
+    // Triangular PV table: pvTable[ply] holds the best line from that ply
+    Move pvTable[MAX_PLY + 1][MAX_PLY + 1];
+    int pvLength[MAX_PLY + 1];
+    
+    SearchStats currentStats(int64_t timeMs) const {
+        SearchStats current = stats;
+        current.nodes = nodes;
+        current.timeMs = timeMs;
+        return current;
+    }
+    
+    int64_t elapsedMs() const {
+        return std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - startTime).count();
+    }
+    
+    // Polled every few thousand nodes; once set, every node unwinds at once
+    bool shouldStop() {
+        if (aborted) return true;
+        if (nodes % CHECK_INTERVAL == 0) {
+            uint64_t totalNodes = nodes;
+            if (sharedNodes) {
+                totalNodes = sharedNodes->fetch_add(nodes - reportedNodes, std::memory_order_relaxed)
+                           + nodes - reportedNodes;
+                reportedNodes = nodes;
+            }
+            aborted = stop->load(std::memory_order_relaxed) ||
+                      (limits.nodes > 0 && totalNodes >= limits.nodes) ||
+                      (limits.timeMs > 0 && elapsedMs() >= limits.timeMs);
+        }
+        return aborted;
+    }
+    
+    // Search the root in a narrow window around the last score, widening
+    // the side that failed until the score falls inside it
+    int aspirationSearch(Position& pos, int depth, bool hasPrevious, int previousScore) {
+        int alpha = -INFINITE_SCORE;
+        int beta = INFINITE_SCORE;
+        int delta = std::max(options.aspirationDelta, 1);
+        
+        if (options.aspirationWindows && depth >= ASPIRATION_MIN_DEPTH && hasPrevious &&
+            !isMateScore(previousScore)) {
+            alpha = std::max(previousScore - delta, -INFINITE_SCORE);
+            beta = std::min(previousScore + delta, INFINITE_SCORE);
+        }
+        
+        while (true) {
+            int score = negamax(pos, depth, alpha, beta, 0);
+            if (aborted) {
+                return 0;
+            }
+            
+            if (score <= alpha && alpha > -INFINITE_SCORE) {
+                alpha = std::max(score - delta, -INFINITE_SCORE);
+            } else if (score >= beta && beta < INFINITE_SCORE) {
+                beta = std::min(score + delta, INFINITE_SCORE);
+            } else {
+                return score;
+            }
+            ++stats.aspirationResearches;
+            delta *= 2;
+        }
+    }
+    
+    int negamax(Position& pos, int depth, int alpha, int beta, int ply, bool allowNull = true) {
+        // Horizon nodes are counted by the quiescence search alone
+        if (depth == 0 || ply >= MAX_PLY) {
+            return quiescence(pos, alpha, beta, ply);
+        }
+        
+        pvLength[ply] = 0;
+        ++nodes;
+        
+        if (shouldStop()) {
+            return 0;
+        }
+        
+        if (ply > 0 && pos.isDraw()) {
+            return 0;
+        }
+        
+        // Reuse earlier results for this position; the root always searches
+        // so that it has a move to return
+        int originalAlpha = alpha;
+        Move hashMove = NULL_MOVE;
+        TTEntry entry;
+        ++stats.ttProbes;
+        if (tt.probe(pos.getHash(), entry)) {
+            ++stats.ttHits;
+            hashMove = entry.move;
+            int ttScore = scoreFromTT(entry.score, ply);
+            if (ply > 0 && entry.depth >= depth &&
+                (entry.bound == BOUND_EXACT ||
+                 (entry.bound == BOUND_LOWER && ttScore >= beta) ||
+                 (entry.bound == BOUND_UPPER && ttScore <= alpha))) {
+                ++stats.ttCutoffs;
+                return ttScore;
+            }
+        }
+        
+        bool inCheck = pos.isInCheck();
+        bool pvNode = beta - alpha > 1;
+        
+        // Null-move pruning: if passing the turn still fails high after a
+        // reduced search, a real move almost certainly would too. Not tried
+        // with only pawns left, where zugzwang makes passing an advantage.
+        if (options.nullMove && allowNull && !pvNode && !inCheck && ply > 0 &&
+            depth >= options.nullMoveMinDepth && std::abs(beta) < MATE_IN_MAX_PLY &&
+            hasNonPawnMaterial(pos) && evaluator.evaluate(pos) >= beta) {
+            int reduction = options.nullMoveReduction + depth / 6;
+            pos.doNullMove();
+            int score = -negamax(pos, std::max(depth - 1 - reduction, 0), -beta, -beta + 1, ply + 1, false);
+            pos.undoNullMove();
+            
+            if (aborted) {
+                return 0;
+            }
+            if (score >= beta) {
+                // Don't trust mate scores found without a real move
+                return score >= MATE_IN_MAX_PLY ? beta : score;
+            }
+        }
+        
+        MoveList moves;
+        moveGen.generateLegalMoves(pos, moves);
+        
+        if (moves.empty()) {
+            // No legal moves - checkmate or stalemate
+            return inCheck ? -MATE_SCORE + ply : 0;
+        }
+        
+        ordering.scoreMoves(pos, moves, hashMove, ply);
+        
+        int bestScore = -INFINITE_SCORE;
+        Move bestMove = NULL_MOVE;
+        
+        int movesSearched = 0;
+        
+        for (size_t i = 0; i < moves.size(); ++i) {
+            pickBest(moves, i);
+            Move move = moves[i];
+            
+            if (ply == 0 && rootExcluded.contains(move)) {
+                continue;
+            }
+            
+            // Principal variation search: once a move has been searched with
+            // the full window, the rest only need to prove they are no
+            // better, which a null window does cheaply; a move that does
+            // beat alpha is searched again for its exact score
+            bool quiet = !isTactical(pos, move) && moves.score(i) < KILLER_SCORE;
+            pos.doMove(move);
+            int score;
+            if (movesSearched++ == 0) {
+                score = -negamax(pos, depth - 1, -beta, -alpha, ply + 1);
+            } else {
+                // Late move reductions: quiet moves this far down the list
+                // rarely matter, so they get a shallower null-window search
+                // first and the full depth only if they beat alpha
+                int reduction = 0;
+                if (options.lateMoveReductions && quiet && !inCheck &&
+                    depth >= options.lmrMinDepth && movesSearched > options.lmrFullDepthMoves &&
+                    !pos.isInCheck()) {
+                    int moveNumber = std::min(movesSearched, LMR_MAX_MOVES - 1);
+                    reduction = std::min(reductions[depth][moveNumber], depth - 2);
+                }
+                
+                score = -negamax(pos, depth - 1 - reduction, -alpha - 1, -alpha, ply + 1);
+                if (reduction > 0 && score > alpha && !aborted) {
+                    score = -negamax(pos, depth - 1, -alpha - 1, -alpha, ply + 1);
+                }
+                if (score > alpha && score < beta && !aborted) {
+                    score = -negamax(pos, depth - 1, -beta, -alpha, ply + 1);
+                }
+            }
+            pos.undoMove();
+            
+            if (aborted) {
+                return 0;
+            }
+            
+            if (score > bestScore) {
+                bestScore = score;
+                
+                if (score > alpha) {
+                    alpha = score;
+                    bestMove = move;
+                    updatePV(ply, move);
+                    
+                    if (alpha >= beta) {
+                        ++stats.betaCutoffs;
+                        if (movesSearched == 1) {
+                            ++stats.firstMoveCutoffs;
+                        }
+                        if (!isTactical(pos, move)) {
+                            ordering.updateQuietStats(pos, move, depth, ply);
+                        }
+                        break;  // Beta cutoff
+                    }
+                }
+            }
+        }
+        
+        Bound bound = bestScore >= beta ? BOUND_LOWER
+                    : bestScore > originalAlpha ? BOUND_EXACT
+                    : BOUND_UPPER;
+        // A root searched without some of its moves has no true score
+        if (ply > 0 || rootExcluded.empty()) {
+            tt.store(pos.getHash(), depth, scoreToTT(bestScore, ply), bound, bestMove);
+        }
+        
+        return bestScore;
+    }
+    
+    // Resolve captures at the horizon so the static evaluation is only
+    // trusted in quiet positions
+    int quiescence(Position& pos, int alpha, int beta, int ply) {
+        pvLength[ply] = 0;
+        ++nodes;
+        ++stats.qnodes;
+        
+        if (shouldStop()) {
+            return 0;
+        }
+        
+        if (ply >= MAX_PLY) {
+            return evaluator.evaluate(pos);
+        }
+        
+        bool inCheck = pos.isInCheck();
+        int standPat = 0;
+        int bestScore = -INFINITE_SCORE;
+        MoveList moves;
+        
+        if (inCheck) {
+            // No standing pat in check: every evasion has to be tried
+            moveGen.generate<EVASIONS>(pos, moves);
+            if (moves.empty()) {
+                return -MATE_SCORE + ply;
+            }
+        } else {
+            // The side to move can usually do at least as well as the
+            // static score by declining every capture
+            standPat = evaluator.evaluate(pos);
+            if (standPat >= beta) {
+                return standPat;
+            }
+            alpha = std::max(alpha, standPat);
+            bestScore = standPat;
+            
+            moveGen.generate<CAPTURES>(pos, moves);
+        }
+        
+        for (size_t i = 0; i < moves.size(); ++i) {
+            moves.score(i) = mvvLva(pos, moves[i]);
+        }
+        
+        for (size_t i = 0; i < moves.size(); ++i) {
+            pickBest(moves, i);
+            Move move = moves[i];
+            
+            // Delta pruning: even winning the piece outright cannot lift
+            // the score to alpha
+            if (!inCheck && standPat + captureGain(pos, move) + DELTA_MARGIN <= alpha) {
+                continue;
+            }
+            
+            // Captures that lose material in the exchange on their square
+            // almost never help; evasions are all needed
+            if (!inCheck && !staticExchangeAtLeast(pos, move, 0)) {
+                continue;
+            }
+            
+            pos.doMove(move);
+            int score = -quiescence(pos, -beta, -alpha, ply + 1);
+            pos.undoMove();
+            
+            if (aborted) {
+                return 0;
+            }
+            
+            if (score > bestScore) {
+                bestScore = score;
+                
+                if (score > alpha) {
+                    alpha = score;
+                    updatePV(ply, move);
+                    
+                    if (alpha >= beta) {
+                        break;
+                    }
+                }
+            }
+        }
+        
+        return bestScore;
+    }
+    
+    void updatePV(int ply, Move move) {
+        pvTable[ply][0] = move;
+        std::copy(pvTable[ply + 1], pvTable[ply + 1] + pvLength[ply + 1], pvTable[ply] + 1);
+        pvLength[ply] = pvLength[ply + 1] + 1;
+    }
+};
+
+uint64_t SearchStats::nodesPerSecond() const {
+    return timeMs > 0 ? nodes * 1000 / static_cast<uint64_t>(timeMs) : 0;
+}
+
+double SearchStats::firstMoveCutoffRate() const {
+    return betaCutoffs > 0 ? static_cast<double>(firstMoveCutoffs) / betaCutoffs : 0.0;
+}
+
+double SearchStats::branchingFactor() const {
+    // Iteration d searches roughly b^d nodes, so b is the d-th root of the
+    // growth between the first and last iterations that did any work
+    auto first = std::find_if(iterations.begin(), iterations.end(),
+                              [](const IterationStats& it) { return it.nodes > 0; });
+    if (first == iterations.end() || iterations.back().depth <= first->depth) {
+        return 0.0;
+    }
+    const IterationStats& last = iterations.back();
+    return std::pow(static_cast<double>(last.nodes) / first->nodes, 1.0 / (last.depth - first->depth));
+}
+
+SearchStats& SearchStats::operator+=(const SearchStats& other) {
+    nodes += other.nodes;
+    qnodes += other.qnodes;
+    ttProbes += other.ttProbes;
+    ttHits += other.ttHits;
+    ttCutoffs += other.ttCutoffs;
+    betaCutoffs += other.betaCutoffs;
+    firstMoveCutoffs += other.firstMoveCutoffs;
+    aspirationResearches += other.aspirationResearches;
+    return *this;
+}
+
+Searcher::Searcher(const Evaluator& evaluator, TranspositionTable& tt, int threadIndex)
+    : pImpl(std::make_unique<Impl>(evaluator, tt, threadIndex)) {}
+
+Searcher::~Searcher() = default;
+
+void Searcher::setOptions(const SearchOptions& options) {
+    pImpl->setOptions(options);
+}
+
+void Searcher::setProgressCallback(SearchProgressCallback callback) {
+    pImpl->setProgressCallback(std::move(callback));
+}
+
+void Searcher::setNodeCounter(std::atomic<uint64_t>* counter) {
+    pImpl->setNodeCounter(counter);
+}
+
+SearchResult Searcher::search(const Position& position, const SearchLimits& limits,
+                              const std::atomic<bool>& stop) {
+    return pImpl->search(position, limits, stop);
+}
+
+} // namespace chess
\ No newline at end of file
@@ -0,0 +1,140 @@
+#include "chess_analyzer/search/transposition_table.h"
+
+namespace chess {
+
+namespace {
+    // Data word layout: move (16) | score (16) | depth (8) | bound (2) | generation (6)
+    uint64_t pack(Move move, int score, int depth, Bound bound, uint8_t generation) {
+        return uint64_t(move.getRaw()) |
+               (uint64_t(uint16_t(int16_t(score))) << 16) |
+               (uint64_t(uint8_t(depth)) << 32) |
+               (uint64_t(bound) << 40) |
+               (uint64_t(generation) << 42);
+    }
+
+    Move moveOf(uint64_t data) {
+        return Move::fromRaw(uint16_t(data));
+    }
+
+    int scoreOf(uint64_t data) {
+        return int16_t(uint16_t(data >> 16));
+    }
+
+    int depthOf(uint64_t data) {
+        return uint8_t(data >> 32);
+    }
+
+    Bound boundOf(uint64_t data) {
+        return Bound((data >> 40) & 0x3);
+    }
+
+    uint8_t generationOf(uint64_t data) {
+        return uint8_t(data >> 42) & 0x3F;
+    }
+}
+
+TranspositionTable::TranspositionTable(size_t megabytes) : mask(0), generation(0) {
+    resize(megabytes);
+}
+
+void TranspositionTable::resize(size_t megabytes) {
+    size_t count = 1;
+    while (count * 2 * sizeof(Bucket) <= megabytes * 1024 * 1024) {
+        count *= 2;
+    }
+    buckets = std::vector<Bucket>(count);
+    mask = count - 1;
+    generation.store(0, std::memory_order_relaxed);
+}
+
+void TranspositionTable::clear() {
+    for (Bucket& bucket : buckets) {
+        for (Entry& entry : bucket.entries) {
+            entry.check.store(0, std::memory_order_relaxed);
+            entry.data.store(0, std::memory_order_relaxed);
+        }
+    }
+    generation.store(0, std::memory_order_relaxed);
+}
+
+bool TranspositionTable::probe(uint64_t key, TTEntry& entry) const {
+    const Bucket& bucket = buckets[key & mask];
+    
+    for (const Entry& slot : bucket.entries) {
+        uint64_t data = slot.data.load(std::memory_order_relaxed);
+        uint64_t check = slot.check.load(std::memory_order_relaxed);
+        
+        if ((check ^ data) == key && boundOf(data) != BOUND_NONE) {
+            entry.move = moveOf(data);
+            entry.score = scoreOf(data);
+            entry.depth = depthOf(data);
+            entry.bound = boundOf(data);
+            return true;
+        }
+    }
+    
+    return false;
+}
+
+void TranspositionTable::store(uint64_t key, int depth, int score, Bound bound, Move move) {
+    Bucket& bucket = buckets[key & mask];
+    uint8_t currentGeneration = generation.load(std::memory_order_relaxed);
+    Entry* replace = nullptr;
+    uint64_t replaceData = 0;
+    int replaceValue = 0;
+    
+    for (Entry& slot : bucket.entries) {
+        uint64_t data = slot.data.load(std::memory_order_relaxed);
+        uint64_t check = slot.check.load(std::memory_order_relaxed);
+        
+        // Same position: always update, but don't let a shallow bound
+        // from this search overwrite a much deeper result
+        if ((check ^ data) == key) {
+            if (bound != BOUND_EXACT && depth + 3 < depthOf(data) &&
+                generationOf(data) == currentGeneration) {
+                return;
+            }
+            replace = &slot;
+            replaceData = data;
+            break;
+        }
+        
+        // Otherwise evict the entry that is shallowest once aged by how
+        // many searches ago it was written
+        int age = (currentGeneration - generationOf(data)) & GENERATION_MASK;
+        int value = depthOf(data) - 8 * age;
+        if (!replace || value < replaceValue) {
+            replace = &slot;
+            replaceData = data;
+            replaceValue = value;
+        }
+    }
+    
+    // Keep the old best move if this search did not produce one
+    if (move == NULL_MOVE && (replace->check.load(std::memory_order_relaxed) ^ replaceData) == key) {
+        move = moveOf(replaceData);
+    }
+    
+    uint64_t data = pack(move, score, depth, bound, currentGeneration);
+    replace->check.store(key ^ data, std::memory_order_relaxed);
+    replace->data.store(data, std::memory_order_relaxed);
+}
+
+int TranspositionTable::hashfull() const {
+    uint8_t currentGeneration = generation.load(std::memory_order_relaxed);
+    size_t sample = buckets.size() < 250 ? buckets.size() : 250;
+    int used = 0;
+    
+    for (size_t i = 0; i < sample; ++i) {
+        for (const Entry& slot : buckets[i].entries) {
+            uint64_t data = slot.data.load(std::memory_order_relaxed);
+            if (boundOf(data) != BOUND_NONE && generationOf(data) == currentGeneration) {
+                ++used;
+            }
+        }
+    }
+    
+    return int(used * 1000 / (sample * ENTRIES_PER_BUCKET));
+}
+
+} // namespace chess
\ No newline at end of file
@@ -0,0 +1,34 @@
+#include <gtest/gtest.h>
+#include "chess_analyzer/explanation/move_explainer.h"
+
+using namespace chess;
+
+class MoveExplainerTest : public ::testing::Test {
+protected:
+    MoveExplainer explainer;
+};
+
+TEST_F(MoveExplainerTest, DescribesCapture) {
+    Position pos("rnbqkbnr/ppp1pppp/8/3p4/4P3/8/PPPP1PPP/RNBQKBNR w KQkq d6 0 2");
+    std::string explanation = explainer.explainMove(pos, Move(E4, D5));
+    
+    EXPECT_NE(explanation.find("capturing a pawn"), std::string::npos) << explanation;
+    EXPECT_EQ(explanation.find("loses material"), std::string::npos) << explanation;
+}
+
+TEST_F(MoveExplainerTest, WarnsAboutLosingCapture) {
+    // The pawn on d5 is defended by e6, so Qxd5 gives up the queen for it
+    Position pos("rnbqkbnr/ppp2ppp/4p3/3p4/8/5Q2/PPPPPPPP/RNB1KBNR w KQkq - 0 3");
+    std::string explanation = explainer.explainMove(pos, Move(F3, D5));
+    
+    EXPECT_NE(explanation.find("this capture loses material"), std::string::npos) << explanation;
+}
+
+TEST_F(MoveExplainerTest, CountsXRayDefenders) {
+    // Rxd5 looks like winning a pawn for free, but the queen behind the
+    // black rook recaptures twice along the file
+    Position pos("3q3k/3r4/8/3p4/8/8/3R4/3R3K w - - 0 1");
+    std::string explanation = explainer.explainMove(pos, Move(D2, D5));
+    
+    EXPECT_NE(explanation.find("loses material"), std::string::npos) << explanation;
+}
\ No newline at end of file
@@ -0,0 +1,230 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include "chess_analyzer/core/move_generator.h"
+#include "chess_analyzer/core/bitboard_attacks.h"
+
+using namespace chess;
+
+class MoveGenerationTest : public ::testing::Test {
+protected:
+    MoveGenerator generator;
+    
+    uint64_t perft(Position& pos, int depth) {
+        if (depth == 0) return 1;
+        
+        MoveList moves;
+        generator.generateLegalMoves(pos, moves);
+        
+        uint64_t nodes = 0;
+        for (const Move& move : moves) {
+            pos.doMove(move);
+            nodes += perft(pos, depth - 1);
+            pos.undoMove();
+        }
+        return nodes;
+    }
+};
+
+TEST_F(MoveGenerationTest, RookAttacksStopAtBlockers) {
+    // Rook on d4 with blockers on d6 and f4
+    Bitboard occupied = squareBB(D6) | squareBB(F4);
+    Bitboard attacks = rookAttacksBB(D4, occupied);
+    
+    EXPECT_TRUE(attacks & squareBB(D6));   // Blocker itself is attacked
+    EXPECT_FALSE(attacks & squareBB(D7));  // Square behind it is not
+    EXPECT_TRUE(attacks & squareBB(F4));
+    EXPECT_FALSE(attacks & squareBB(G4));
+    EXPECT_EQ(popcount(attacks), 2 + 3 + 2 + 3);
+}
+
+TEST_F(MoveGenerationTest, BishopAttacksOnEmptyBoard) {
+    EXPECT_EQ(popcount(bishopAttacksBB(A1, 0)), 7);
+    EXPECT_EQ(popcount(bishopAttacksBB(D4, 0)), 13);
+    EXPECT_EQ(queenAttacksBB(D4, 0), bishopAttacksBB(D4, 0) | rookAttacksBB(D4, 0));
+}
+
+TEST_F(MoveGenerationTest, MagicIndicesStayInsideTable) {
+    for (Square sq = A1; sq <= H8; ++sq) {
+        EXPECT_LT(rookMagics[sq].index(~0ULL), 1u << (64 - rookMagics[sq].shift));
+        EXPECT_LT(bishopMagics[sq].index(~0ULL), 1u << (64 - bishopMagics[sq].shift));
+    }
+}
+
+TEST_F(MoveGenerationTest, SlidingBackendsAgree) {
+    if (!cpuHasFastPext()) {
+        GTEST_SKIP() << "PEXT backend not available on this CPU";
+    }
+    
+    SlidingBackend original = getSlidingBackend();
+    Bitboard occupied = squareBB(D6) | squareBB(F4) | squareBB(B2) | squareBB(G7) | squareBB(C5);
+    Bitboard rook[64], bishop[64];
+    
+    ASSERT_TRUE(setSlidingBackend(SlidingBackend::MAGIC));
+    for (Square sq = A1; sq <= H8; ++sq) {
+        rook[sq] = rookAttacksBB(sq, occupied);
+        bishop[sq] = bishopAttacksBB(sq, occupied);
+    }
+    
+    ASSERT_TRUE(setSlidingBackend(SlidingBackend::PEXT));
+    for (Square sq = A1; sq <= H8; ++sq) {
+        EXPECT_EQ(rookAttacksBB(sq, occupied), rook[sq]);
+        EXPECT_EQ(bishopAttacksBB(sq, occupied), bishop[sq]);
+    }
+    
+    setSlidingBackend(original);
+}
+
+TEST_F(MoveGenerationTest, DoubleCheckAllowsOnlyKingMoves) {
+    // Rook e1 and bishop b5 both check the king on e8
+    Position pos("4k3/8/8/1B6/8/8/8/4R1K1 b - - 0 1");
+    Position withDefender("r3k3/8/8/1B6/8/8/8/4R1K1 b - - 0 1");
+    
+    for (const Position& p : {pos, withDefender}) {
+        for (const Move& move : generator.generateLegalMoves(p)) {
+            EXPECT_EQ(move.from(), E8) << move.toUCI();
+        }
+    }
+}
+
+TEST_F(MoveGenerationTest, PinnedPiecesStayOnPinLine) {
+    // Rook e8 pins the knight on e4 and bishop b4 pins the pawn on d2 against the king
+    Position pos("4r1k1/8/8/8/1b2N3/8/3P4/4K3 w - - 0 1");
+    for (const Move& move : generator.generateLegalMoves(pos)) {
+        EXPECT_NE(move.from(), E4) << move.toUCI();  // Knights can never move when pinned
+        EXPECT_NE(move.from(), D2) << move.toUCI();  // Pushes would leave the diagonal
+    }
+}
+
+TEST_F(MoveGenerationTest, EnPassantDiscoveredCheckIsIllegal) {
+    // exd6 e.p. would clear the fifth rank between the king and the rook
+    Position pos("8/8/8/K2pP2r/8/8/8/7k w - d6 0 1");
+    EXPECT_FALSE(generator.isLegal(pos, Move(E5, D6, EN_PASSANT)));
+    
+    // Capturing the checking pawn en passant is fine
+    Position evasion("8/8/8/2k5/3Pp3/8/8/4K3 b - d3 0 1");
+    EXPECT_TRUE(generator.isLegal(evasion, Move(E4, D3, EN_PASSANT)));
+}
+
+TEST_F(MoveGenerationTest, IsLegalRejectsImpossibleMoves) {
+    Position pos;
+    EXPECT_TRUE(generator.isLegal(pos, Move(E2, E4)));
+    EXPECT_FALSE(generator.isLegal(pos, Move(E2, E5)));
+    EXPECT_FALSE(generator.isLegal(pos, Move(D1, D4)));
+}
+
+TEST_F(MoveGenerationTest, MoveListOverloadsMatchVectors) {
+    Position pos("r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1");
+    
+    MoveList legal, captures, quiets;
+    generator.generateLegalMoves(pos, legal);
+    generator.generateCaptures(pos, captures);
+    generator.generateQuietMoves(pos, quiets);
+    
+    std::vector<Move> legalVector = generator.generateLegalMoves(pos);
+    ASSERT_EQ(legal.size(), legalVector.size());
+    EXPECT_TRUE(std::equal(legal.begin(), legal.end(), legalVector.begin()));
+    EXPECT_EQ(captures.size(), generator.generateCaptures(pos).size());
+    EXPECT_EQ(quiets.size(), generator.generateQuietMoves(pos).size());
+    EXPECT_EQ(captures.size() + quiets.size(), legal.size());
+}
+
+TEST_F(MoveGenerationTest, GenerationModesMatchFilteredLegalMoves) {
+    // Each mode must equal the legal moves filtered by its definition, in
+    // every position two plies deep from a few tactical roots
+    auto sorted = [](const MoveList& list) {
+        std::vector<Move> moves(list.begin(), list.end());
+        std::sort(moves.begin(), moves.end(), [](const Move& a, const Move& b) {
+            return a.getRaw() < b.getRaw();
+        });
+        return moves;
+    };
+    
+    auto check = [&](const Position& pos) {
+        MoveList legal, captures, quiets, quietChecks;
+        generator.generate<LEGAL>(pos, legal);
+        generator.generate<CAPTURES>(pos, captures);
+        generator.generate<QUIETS>(pos, quiets);
+        generator.generate<QUIET_CHECKS>(pos, quietChecks);
+        
+        MoveList expectedCaptures, expectedQuiets, expectedChecks;
+        for (const Move& move : legal) {
+            bool capture = pos.getPieceAt(move.to()) != NO_PIECE || move.isEnPassant();
+            bool queenPromotion = move.isPromotion() && move.promotionType() == PROMOTE_TO_QUEEN;
+            if (move.isPromotion() ? queenPromotion : capture) {
+                expectedCaptures.push_back(move);
+            } else {
+                expectedQuiets.push_back(move);
+            }
+            if (!capture && !move.isPromotion() && pos.givesCheck(move)) {
+                expectedChecks.push_back(move);
+            }
+        }
+        
+        std::string fen = pos.toFEN();
+        EXPECT_EQ(sorted(captures), sorted(expectedCaptures)) << fen;
+        EXPECT_EQ(sorted(quiets), sorted(expectedQuiets)) << fen;
+        EXPECT_EQ(sorted(quietChecks), sorted(expectedChecks)) << fen;
+        
+        if (pos.isInCheck()) {
+            MoveList evasions;
+            generator.generate<EVASIONS>(pos, evasions);
+            EXPECT_EQ(sorted(evasions), sorted(legal)) << fen;
+        }
+    };
+    
+    const char* fens[] = {
+        "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+        "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1",
+        "r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1",
+        "rnbq1k1r/pp1Pbppp/2p5/8/2B5/8/PPP1NnPP/RNBQK2R w KQ - 1 8"
+    };
+    
+    for (const char* fen : fens) {
+        Position root(fen);
+        check(root);
+        
+        MoveList first;
+        generator.generateLegalMoves(root, first);
+        for (const Move& move : first) {
+            root.doMove(move);
+            check(root);
+            
+            MoveList second;
+            generator.generateLegalMoves(root, second);
+            for (const Move& reply : second) {
+                root.doMove(reply);
+                check(root);
+                root.undoMove();
+            }
+            root.undoMove();
+        }
+    }
+}
+
+TEST_F(MoveGenerationTest, PerftStartingPosition) {
+    Position pos;
+    EXPECT_EQ(perft(pos, 1), 20u);
+    EXPECT_EQ(perft(pos, 2), 400u);
+    EXPECT_EQ(perft(pos, 3), 8902u);
+}
+
+TEST_F(MoveGenerationTest, PerftKiwipete) {
+    Position pos("r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1");
+    EXPECT_EQ(perft(pos, 1), 48u);
+    EXPECT_EQ(perft(pos, 2), 2039u);
+    EXPECT_EQ(perft(pos, 3), 97862u);
+}
+
+TEST_F(MoveGenerationTest, PerftEndgameWithEnPassantPins) {
+    Position pos("8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1");
+    EXPECT_EQ(perft(pos, 4), 43238u);
+    EXPECT_EQ(perft(pos, 5), 674624u);
+}
+
+TEST_F(MoveGenerationTest, PerftPromotionsAndChecks) {
+    Position pos("r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1");
+    EXPECT_EQ(perft(pos, 3), 9467u);
+    
+    Position pos5("rnbq1k1r/pp1Pbppp/2p5/8/2B5/8/PPP1NnPP/RNBQK2R w KQ - 1 8");
+    EXPECT_EQ(perft(pos5, 3), 62379u);
+}
\ No newline at end of file
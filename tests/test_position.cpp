@@ -1,5 +1,10 @@
 #include <gtest/gtest.h>
 #include "chess_analyzer/core/position.h"
+#include "chess_analyzer/core/move.h"
+#include "chess_analyzer/core/move_generator.h"
+#include "chess_analyzer/core/see.h"
+#include "chess_analyzer/evaluation/evaluator.h"
+#include "chess_analyzer/core/piece_square_tables.h"
 
 using namespace chess;
 
@@ -102,6 +107,34 @@ TEST_F(PositionTest, ColorBitboardsAreCorrect) {
     EXPECT_EQ(whitePieces | blackPieces, allPieces);
 }
 
+TEST_F(PositionTest, CachedBoardsTrackMoves) {
+    Position pos("r3k2r/pPpp1ppp/8/3Pp3/8/8/P1PP1PPP/R3K2R w KQkq e6 0 1");
+    const Move moves[] = {Move(D5, E6, EN_PASSANT), Move(E8, C8, CASTLING),
+                          Move(B7, A8, PROMOTION, PROMOTE_TO_KNIGHT), Move(H8, H2)};
+    
+    for (const Move& move : moves) {
+        pos.doMove(move);
+        
+        for (Color c : {WHITE, BLACK}) {
+            Bitboard colorBB = 0;
+            for (PieceType pt = PAWN; pt <= KING; pt = static_cast<PieceType>(pt + 1)) {
+                Bitboard pieces = pos.getPieceBitboard(pt, c);
+                colorBB |= pieces;
+                while (pieces) {
+                    EXPECT_EQ(pos.getPieceAt(popLsb(pieces)), makePiece(c, pt)) << move.toUCI();
+                }
+            }
+            EXPECT_EQ(pos.getColorBitboard(c), colorBB) << move.toUCI();
+        }
+        EXPECT_EQ(pos.getOccupiedBitboard(), pos.getColorBitboard(WHITE) | pos.getColorBitboard(BLACK));
+        
+        for (Square sq = A1; sq <= H8; ++sq) {
+            bool occupied = pos.getOccupiedBitboard() & squareBB(sq);
+            EXPECT_EQ(pos.getPieceAt(sq) != NO_PIECE, occupied) << squareToString(sq);
+        }
+    }
+}
+
 TEST_F(PositionTest, EnPassantSquareHandling) {
     // Position after 1.e4 e5 2.Nf3 Nf6 3.d4 exd4
     Position pos("rnbqkb1r/pppp1ppp/5n2/8/3pP3/5N2/PPP2PPP/RNBQKB1R w KQkq - 0 4");
@@ -114,13 +147,255 @@ TEST_F(PositionTest, EnPassantSquareHandling) {
 
 TEST_F(PositionTest, CastlingRightsUpdate) {
     // Position where white has lost queenside castling
-    Position pos("r3k2r/pppppppp/8/8/8/8/PPPPPPPP/R3K2R w KQk - 0 1");
+    Position pos("r3k2r/pppppppp/8/8/8/8/PPPPPPPP/R3K2R w Kkq - 0 1");
     EXPECT_TRUE(pos.getCastlingRights() & WHITE_OO);
     EXPECT_FALSE(pos.getCastlingRights() & WHITE_OOO);
     EXPECT_TRUE(pos.getCastlingRights() & BLACK_OO);
     EXPECT_TRUE(pos.getCastlingRights() & BLACK_OOO);
 }
 
+TEST_F(PositionTest, HashMatchesRecomputeAfterMoves) {
+    Position pos;
+    EXPECT_NE(pos.getHash(), 0u);
+    EXPECT_EQ(pos.getHash(), pos.computeHash());
+    
+    // Double push (sets ep), capture, castling-rights loss and castling
+    const char* moves[] = {"e2e4", "d7d5", "e4d5", "g8f6", "f1b5", "c7c6",
+                           "d5c6", "b8c6", "g1f3", "e7e5", "e1g1", "a8b8"};
+    for (const char* uci : moves) {
+        Move move = Move::fromUCI(uci);
+        pos = pos.makeMove(move);
+        EXPECT_EQ(pos.getHash(), pos.computeHash()) << "after " << uci;
+    }
+    
+    // The FEN round trip must land on the same key
+    EXPECT_EQ(Position(pos.toFEN()).getHash(), pos.getHash());
+}
+
+TEST_F(PositionTest, HashDetectsTranspositions) {
+    Position start;
+    Position pos = start;
+    for (const char* uci : {"g1f3", "g8f6", "f3g1", "f6g8"}) {
+        pos = pos.makeMove(Move::fromUCI(uci));
+    }
+    
+    // Same placement, side and rights; only the clocks differ
+    EXPECT_EQ(pos.getHash(), start.getHash());
+}
+
+TEST_F(PositionTest, HashCoversSideCastlingAndEnPassant) {
+    Position base("r3k2r/pppppppp/8/8/4P3/8/PPPP1PPP/R3K2R b KQkq e3 0 1");
+    
+    EXPECT_NE(base.getHash(), Position("r3k2r/pppppppp/8/8/4P3/8/PPPP1PPP/R3K2R w KQkq e3 0 1").getHash());
+    EXPECT_NE(base.getHash(), Position("r3k2r/pppppppp/8/8/4P3/8/PPPP1PPP/R3K2R b Kkq e3 0 1").getHash());
+    EXPECT_NE(base.getHash(), Position("r3k2r/pppppppp/8/8/4P3/8/PPPP1PPP/R3K2R b KQkq - 0 1").getHash());
+}
+
+TEST_F(PositionTest, UndoMoveRestoresPosition) {
+    // Castling, en passant and promotions are all available here
+    const std::string fen = "r3k2r/pPpp1ppp/8/3Pp3/8/8/P1PP1PPP/R3K2R w KQkq e6 0 1";
+    Position pos(fen);
+    uint64_t hash = pos.getHash();
+    
+    for (const char* uci : {"e1g1", "e1c1", "d5e6", "b7a8q", "b7b8n", "a1a8", "h1h7"}) {
+        Move move = Move::fromUCI(uci);
+        if (std::string(uci) == "d5e6") {
+            move = Move(D5, E6, EN_PASSANT);
+        }
+        
+        pos.doMove(move);
+        EXPECT_NE(pos.toFEN(), fen) << uci;
+        pos.undoMove();
+        
+        EXPECT_EQ(pos.toFEN(), fen) << "after undoing " << uci;
+        EXPECT_EQ(pos.getHash(), hash) << "after undoing " << uci;
+    }
+}
+
+TEST_F(PositionTest, CopiesKeepTheirOwnUndoHistory) {
+    const std::string start = Position().toFEN();
+    Position pos;
+    pos.doMove(Move(E2, E4));
+    pos.doMove(Move(E7, E5));
+    const std::string afterE5 = pos.toFEN();
+    
+    Position copy = pos;
+    copy.doMove(Move(G1, F3));
+    pos.doMove(Move(D2, D4));
+    
+    copy.undoMove();
+    EXPECT_EQ(copy.toFEN(), afterE5);
+    copy.undoMove();
+    copy.undoMove();
+    EXPECT_EQ(copy.toFEN(), start);
+    
+    // Assignment replaces the history too
+    copy = pos;
+    copy.undoMove();
+    EXPECT_EQ(copy.toFEN(), afterE5);
+    
+    pos.undoMove();
+    pos.undoMove();
+    pos.undoMove();
+    EXPECT_EQ(pos.toFEN(), start);
+}
+
+TEST_F(PositionTest, LongGamesOutgrowTheReservedStack) {
+    // Shuffle the knights for far more plies than any reserve covers
+    const Move cycle[] = {Move(G1, F3), Move(G8, F6), Move(F3, G1), Move(F6, G8)};
+    const std::string start = Position().toFEN();
+    const int plies = 1100;
+    
+    Position pos;
+    for (int i = 0; i < plies; ++i) {
+        pos.doMove(cycle[i % 4]);
+    }
+    Position copy = pos;
+    
+    for (int i = 0; i < plies; ++i) {
+        pos.undoMove();
+    }
+    EXPECT_EQ(pos.toFEN(), start);
+    EXPECT_EQ(pos.getHash(), Position().getHash());
+    
+    copy.undoMove();
+    EXPECT_EQ(copy.getPieceAt(F6), B_KNIGHT);
+}
+
+TEST_F(PositionTest, NullMovePassesTurnAndUndoes) {
+    const std::string fen = "rnbqkbnr/pppp1ppp/8/4p3/4P3/8/PPPP1PPP/RNBQKBNR w KQkq e6 0 2";
+    Position pos(fen);
+    uint64_t hash = pos.getHash();
+    
+    pos.doNullMove();
+    EXPECT_EQ(pos.getSideToMove(), BLACK);
+    EXPECT_EQ(pos.getEnPassantSquare(), NO_SQUARE);
+    EXPECT_EQ(pos.getHash(), pos.computeHash());
+    EXPECT_EQ(pos.getHash(), Position("rnbqkbnr/pppp1ppp/8/4p3/4P3/8/PPPP1PPP/RNBQKBNR b KQkq - 1 2").getHash());
+    
+    pos.undoNullMove();
+    EXPECT_EQ(pos.toFEN(), fen);
+    EXPECT_EQ(pos.getHash(), hash);
+}
+
+TEST_F(PositionTest, AttackersToSeesThroughRemovedPieces) {
+    Position pos("3q3k/3r4/8/3p4/8/8/3R4/3R3K w - - 0 1");
+    Bitboard occupied = pos.getOccupiedBitboard();
+    
+    EXPECT_EQ(pos.attackersTo(D5, occupied), squareBB(D7) | squareBB(D2));
+    
+    // With the front rooks gone, the pieces behind them attack d5 too
+    occupied ^= squareBB(D7) | squareBB(D2);
+    EXPECT_EQ(pos.attackersTo(D5, occupied) & occupied, squareBB(D8) | squareBB(D1));
+}
+
+TEST_F(PositionTest, StaticExchangeResolvesCaptureSequences) {
+    struct Case {
+        const char* fen;
+        Move move;
+        int expected;
+    };
+    const Case cases[] = {
+        // Undefended pawn
+        {"4k3/8/8/3p4/8/8/8/3RK3 w - - 0 1", Move(D1, D5), PieceValue::PAWN},
+        // Pawn defended by a pawn: the rook is lost for it
+        {"4k3/8/4p3/3p4/8/8/8/3RK3 w - - 0 1", Move(D1, D5), PieceValue::PAWN - PieceValue::ROOK},
+        // Knight takes a defended pawn, pawn recaptures
+        {"4k3/8/4p3/3p4/8/4N3/8/4K3 w - - 0 1", Move(E3, D5), PieceValue::PAWN - PieceValue::KNIGHT},
+        // X-ray: doubled rooks against a rook and a queen behind it
+        {"3q3k/3r4/8/3p4/8/8/3R4/3R3K w - - 0 1", Move(D2, D5), PieceValue::PAWN - PieceValue::ROOK},
+        // Pawn takes a defended queen: always wins
+        {"4k3/8/4p3/3q4/4P3/8/8/4K3 w - - 0 1", Move(E4, D5), PieceValue::QUEEN - PieceValue::PAWN},
+        // King may only recapture on an undefended square
+        {"4k3/8/8/3p4/4K3/8/8/8 w - - 0 1", Move(E4, D5), PieceValue::PAWN},
+        // A queen move to an attacked square can be won
+        {"4k3/8/4p3/8/8/8/8/3QK3 w - - 0 1", Move(D1, D5), -PieceValue::QUEEN},
+    };
+    
+    for (const Case& c : cases) {
+        Position pos(c.fen);
+        EXPECT_EQ(staticExchange(pos, c.move), c.expected) << c.fen;
+        EXPECT_EQ(staticExchangeAtLeast(pos, c.move, 0), c.expected >= 0) << c.fen;
+    }
+}
+
+TEST_F(PositionTest, EvaluationSumsFollowMoves) {
+    // Castling, en passant and promotions all move pieces in unusual ways
+    Position pos("r3k2r/pPpp1ppp/8/3Pp3/8/8/P1PP1PPP/R3K2R w KQkq e6 0 1");
+    const int material = pos.getMaterial();
+    const Score psqtScore = pos.getPsqt();
+    const int phase = pos.getGamePhase();
+    
+    MoveGenerator moveGen;
+    for (const Move& move : moveGen.generateLegalMoves(pos)) {
+        pos.doMove(move);
+        for (const Move& reply : moveGen.generateLegalMoves(pos)) {
+            pos.doMove(reply);
+            Position fresh(pos.toFEN());
+            ASSERT_EQ(pos.getMaterial(), fresh.getMaterial()) << pos.toFEN();
+            ASSERT_EQ(pos.getPsqt(), fresh.getPsqt()) << pos.toFEN();
+            ASSERT_EQ(pos.getGamePhase(), fresh.getGamePhase()) << pos.toFEN();
+            pos.undoMove();
+        }
+        pos.undoMove();
+    }
+    
+    EXPECT_EQ(pos.getMaterial(), material);
+    EXPECT_EQ(pos.getPsqt(), psqtScore);
+    EXPECT_EQ(pos.getGamePhase(), phase);
+    
+    // Symmetric positions balance out
+    Position start;
+    EXPECT_EQ(start.getMaterial(), 0);
+    EXPECT_EQ(start.getPsqt(), SCORE_ZERO);
+    EXPECT_EQ(start.getGamePhase(), MAX_PHASE);
+    EXPECT_EQ(Position("4k3/8/8/8/8/8/8/3QK3 w - - 0 1").getMaterial(), PieceValue::QUEEN);
+    EXPECT_EQ(Position("4k3/8/8/8/8/8/8/3QK3 w - - 0 1").getGamePhase(), 4);
+}
+
+TEST_F(PositionTest, PackedScoresKeepBothHalves) {
+    const int values[] = {0, 1, -1, 37, -250, 900, -10000, 10000};
+    for (int mg : values) {
+        for (int eg : values) {
+            Score s = makeScore(mg, eg);
+            EXPECT_EQ(mgValue(s), mg);
+            EXPECT_EQ(egValue(s), eg);
+            EXPECT_EQ(mgValue(-s), -mg);
+            EXPECT_EQ(egValue(-s), -eg);
+            EXPECT_EQ(egValue(s * 3), eg * 3);
+        }
+    }
+    
+    Score sum = makeScore(-30, 45) + makeScore(10, -90) - makeScore(5, 5);
+    EXPECT_EQ(mgValue(sum), -25);
+    EXPECT_EQ(egValue(sum), -50);
+}
+
+TEST_F(PositionTest, GivesCheckMatchesMakeMove) {
+    struct Case {
+        const char* fen;
+        Move move;
+        bool check;
+    };
+    
+    const Case cases[] = {
+        {"3k4/8/8/8/8/8/1B6/R3K2R w KQ - 0 1", Move(A1, A8), true},                  // Direct
+        {"3k4/8/8/8/8/8/1B6/R3K2R w KQ - 0 1", Move(B2, A3), false},
+        {"3k4/8/8/8/8/8/1B6/R3K2R w KQ - 0 1", Move(E1, C1, CASTLING), true},        // Rook lands on d1
+        {"3k4/8/8/8/8/8/1B6/R3K2R w KQ - 0 1", Move(E1, G1, CASTLING), false},
+        {"4k3/8/8/8/4N3/8/8/4R1K1 w - - 0 1", Move(E4, C3), true},                   // Discovered
+        {"8/8/8/k1Pp3R/8/8/8/4K3 w - d6 0 1", Move(C5, D6, EN_PASSANT), true},       // Both pawns leave the rank
+        {"3k4/P7/8/8/8/8/8/4K3 w - - 0 1", Move(A7, A8, PROMOTION, PROMOTE_TO_QUEEN), true},
+        {"3k4/P7/8/8/8/8/8/4K3 w - - 0 1", Move(A7, A8, PROMOTION, PROMOTE_TO_KNIGHT), false},
+    };
+    
+    for (const Case& c : cases) {
+        Position pos(c.fen);
+        EXPECT_EQ(pos.givesCheck(c.move), c.check) << c.fen << " " << c.move.toUCI();
+        EXPECT_EQ(pos.makeMove(c.move).isInCheck(), c.check) << c.fen << " " << c.move.toUCI();
+    }
+}
+
 // Perft test - counts positions at a given depth
 // This is a standard test for move generation correctness
 TEST_F(PositionTest, PerftStartingPosition) {
@@ -0,0 +1,580 @@
+#include <gtest/gtest.h>
+#include "chess_analyzer.h"
+#include "chess_analyzer/core/move_generator.h"
+#include "chess_analyzer/search/move_ordering.h"
+#include "chess_analyzer/search/transposition_table.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+using namespace chess;
+
+class SearchTest : public ::testing::Test {
+protected:
+    ChessAnalyzer analyzer;
+};
+
+TEST_F(SearchTest, TranspositionTableRoundTrip) {
+    TranspositionTable tt(1);
+    const uint64_t key = 0x123456789ABCDEF0ULL;
+    
+    TTEntry entry;
+    EXPECT_FALSE(tt.probe(key, entry));
+    
+    tt.store(key, 7, -29990, BOUND_LOWER, Move(E2, E4));
+    ASSERT_TRUE(tt.probe(key, entry));
+    EXPECT_EQ(entry.move, Move(E2, E4));
+    EXPECT_EQ(entry.score, -29990);
+    EXPECT_EQ(entry.depth, 7);
+    EXPECT_EQ(entry.bound, BOUND_LOWER);
+    
+    // A fail-low result without a move keeps the stored best move
+    tt.store(key, 8, 15, BOUND_UPPER, NULL_MOVE);
+    ASSERT_TRUE(tt.probe(key, entry));
+    EXPECT_EQ(entry.move, Move(E2, E4));
+    EXPECT_EQ(entry.depth, 8);
+    
+    // Keys sharing a bucket but differing elsewhere do not match
+    EXPECT_FALSE(tt.probe(key ^ (1ULL << 63), entry));
+    
+    tt.clear();
+    EXPECT_FALSE(tt.probe(key, entry));
+}
+
+TEST_F(SearchTest, TranspositionTableReplacesShallowEntries) {
+    TranspositionTable tt(1);
+    
+    // Fill one bucket with deep entries, then add a shallow one that
+    // collides; the new entry must evict the shallowest, not a deep one
+    const uint64_t base = 0x40;
+    for (uint64_t i = 1; i <= 4; ++i) {
+        tt.store(base | (i << 40), int(10 + i), 0, BOUND_EXACT, NULL_MOVE);
+    }
+    tt.store(base | (5ULL << 40), 1, 0, BOUND_EXACT, NULL_MOVE);
+    
+    TTEntry entry;
+    EXPECT_FALSE(tt.probe(base | (1ULL << 40), entry));
+    EXPECT_TRUE(tt.probe(base | (4ULL << 40), entry));
+    EXPECT_TRUE(tt.probe(base | (5ULL << 40), entry));
+}
+
+// Legal moves in the order the search would try them
+static std::vector<Move> orderedMoves(const MoveOrdering& ordering, const Position& pos,
+                                      Move hashMove, int ply) {
+    MoveList moves;
+    MoveGenerator().generateLegalMoves(pos, moves);
+    ordering.scoreMoves(pos, moves, hashMove, ply);
+    
+    std::vector<std::pair<int, Move>> scored;
+    for (size_t i = 0; i < moves.size(); ++i) {
+        scored.emplace_back(moves.score(i), moves[i]);
+    }
+    std::stable_sort(scored.begin(), scored.end(), [](const auto& a, const auto& b) {
+        return a.first > b.first;
+    });
+    
+    std::vector<Move> ordered;
+    for (const auto& entry : scored) {
+        ordered.push_back(entry.second);
+    }
+    return ordered;
+}
+
+TEST_F(SearchTest, HashMoveIsSearchedFirst) {
+    // A quiet hash move goes ahead of a capture winning the queen
+    Position pos("4k3/8/8/3q4/4P3/8/8/4K2R w K - 0 1");
+    MoveOrdering ordering;
+    
+    std::vector<Move> ordered = orderedMoves(ordering, pos, Move(H1, H2), 0);
+    EXPECT_EQ(ordered[0], Move(H1, H2));
+    EXPECT_EQ(ordered[1], Move(E4, D5));
+    
+    // Without one the winning capture leads
+    EXPECT_EQ(orderedMoves(ordering, pos, NULL_MOVE, 0)[0], Move(E4, D5));
+}
+
+TEST_F(SearchTest, CapturesOrderedByVictimThenAttacker) {
+    // exd5 and Qxd5 both take the queen, Qxa4 only a pawn
+    Position pos("4k3/8/8/3q4/p3P3/8/8/3QK3 w - - 0 1");
+    MoveOrdering ordering;
+    std::vector<Move> ordered = orderedMoves(ordering, pos, NULL_MOVE, 0);
+    
+    ASSERT_GE(ordered.size(), 4u);
+    EXPECT_EQ(ordered[0], Move(E4, D5));
+    EXPECT_EQ(ordered[1], Move(D1, D5));
+    EXPECT_EQ(ordered[2], Move(D1, A4));
+    EXPECT_FALSE(isTactical(pos, ordered[3]));
+    EXPECT_GT(mvvLva(pos, Move(E4, D5)), mvvLva(pos, Move(D1, D5)));
+    EXPECT_GT(mvvLva(pos, Move(D1, D5)), mvvLva(pos, Move(D1, A4)));
+}
+
+TEST_F(SearchTest, LosingCapturesComeAfterQuietMoves) {
+    // Qxd5 is recaptured by the c6 pawn
+    Position pos("4k3/8/2p5/3p4/8/8/8/3QK3 w - - 0 1");
+    MoveOrdering ordering;
+    std::vector<Move> ordered = orderedMoves(ordering, pos, NULL_MOVE, 0);
+    
+    EXPECT_EQ(ordered.back(), Move(D1, D5));
+    for (size_t i = 0; i + 1 < ordered.size(); ++i) {
+        EXPECT_FALSE(isTactical(pos, ordered[i])) << ordered[i].toUCI();
+    }
+}
+
+TEST_F(SearchTest, KillersLeadQuietMovesAtTheirPly) {
+    Position pos;
+    MoveOrdering ordering;
+    ordering.updateQuietStats(pos, Move(G1, F3), 3, 2);
+    ordering.updateQuietStats(pos, Move(B1, C3), 3, 2);
+    EXPECT_EQ(ordering.killer(2, 0), Move(B1, C3));
+    EXPECT_EQ(ordering.killer(2, 1), Move(G1, F3));
+    
+    // Storing the newest killer again keeps both slots
+    ordering.updateQuietStats(pos, Move(B1, C3), 3, 2);
+    EXPECT_EQ(ordering.killer(2, 1), Move(G1, F3));
+    
+    std::vector<Move> ordered = orderedMoves(ordering, pos, NULL_MOVE, 2);
+    EXPECT_EQ(ordered[0], Move(B1, C3));
+    EXPECT_EQ(ordered[1], Move(G1, F3));
+    
+    // Other plies get the history credit but never the killer bonus
+    MoveList moves;
+    MoveGenerator().generateLegalMoves(pos, moves);
+    ordering.scoreMoves(pos, moves, NULL_MOVE, 3);
+    for (size_t i = 0; i < moves.size(); ++i) {
+        EXPECT_LT(moves.score(i), KILLER_SCORE) << moves[i].toUCI();
+    }
+    
+    ordering.clear();
+    EXPECT_EQ(ordering.killer(2, 0), NULL_MOVE);
+    EXPECT_EQ(ordering.historyScore(WHITE, Move(B1, C3)), 0);
+}
+
+TEST_F(SearchTest, HistoryIsHalvedAtItsLimit) {
+    Position pos;
+    MoveOrdering ordering;
+    ordering.updateQuietStats(pos, Move(G1, F3), 10, 0);
+    EXPECT_EQ(ordering.historyScore(WHITE, Move(G1, F3)), 100);
+    EXPECT_EQ(ordering.historyScore(BLACK, Move(G1, F3)), 0);
+    
+    // Keep crediting one move until it reaches the limit
+    int previous = 0;
+    while (true) {
+        ordering.updateQuietStats(pos, Move(E2, E4), 100, 0);
+        int current = ordering.historyScore(WHITE, Move(E2, E4));
+        ASSERT_LT(current, HISTORY_MAX);
+        if (current < previous) {
+            break;
+        }
+        previous = current;
+    }
+    
+    // Every counter was halved, not just the one that overflowed
+    EXPECT_EQ(ordering.historyScore(WHITE, Move(E2, E4)), (previous + 100 * 100) / 2);
+    EXPECT_EQ(ordering.historyScore(WHITE, Move(G1, F3)), 50);
+}
+
+TEST_F(SearchTest, FindsMateInOne) {
+    // Scholar's mate: Qxf7#
+    Position pos("r1bqkb1r/pppp1ppp/2n2n2/4p2Q/2B1P3/8/PPPP1PPP/RNB1K1NR w KQkq - 4 4");
+    EXPECT_EQ(analyzer.findBestMove(pos, 3), Move(H5, F7));
+}
+
+TEST_F(SearchTest, RepeatedSearchesAgree) {
+    // A second search reuses the table and must not change its answer
+    Position pos("r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1");
+    Move first = analyzer.findBestMove(pos, 4);
+    Move second = analyzer.findBestMove(pos, 4);
+    EXPECT_EQ(first, second);
+    
+    analyzer.clearHash();
+    EXPECT_EQ(analyzer.findBestMove(pos, 4), first);
+}
+
+TEST_F(SearchTest, IterativeDeepeningReportsLegalPV) {
+    Position pos("r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1");
+    SearchLimits limits;
+    limits.depth = 4;
+    
+    SearchResult result = analyzer.search(pos, limits);
+    EXPECT_EQ(result.depth, 4);
+    ASSERT_FALSE(result.pv.empty());
+    EXPECT_EQ(result.pv.front(), result.bestMove);
+    EXPECT_GT(result.nodes, 0u);
+    
+    // Every PV move must be legal in the position it is played from
+    for (const Move& move : result.pv) {
+        ASSERT_TRUE(analyzer.isLegalMove(pos, move)) << move.toUCI();
+        pos.doMove(move);
+    }
+}
+
+TEST_F(SearchTest, NodeLimitStopsSearch) {
+    Position pos;
+    SearchLimits limits;
+    limits.nodes = 20000;
+    
+    SearchResult result = analyzer.search(pos, limits);
+    EXPECT_TRUE(analyzer.isLegalMove(pos, result.bestMove));
+    EXPECT_GE(result.depth, 1);
+    EXPECT_LT(result.nodes, 30000u);
+}
+
+TEST_F(SearchTest, NodeLimitCoversAllThreads) {
+    Position pos("r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1");
+    analyzer.setThreads(4);
+    SearchLimits limits;
+    limits.nodes = 50000;
+    
+    SearchResult result = analyzer.search(pos, limits);
+    EXPECT_TRUE(analyzer.isLegalMove(pos, result.bestMove));
+    EXPECT_EQ(result.nodes, result.stats.nodes);
+    
+    // Each thread may overrun by one check interval before it notices
+    EXPECT_LT(result.nodes, limits.nodes + 4 * 4096u);
+}
+
+TEST_F(SearchTest, TimeLimitStopsSearch) {
+    Position pos("r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1");
+    SearchLimits limits;
+    limits.timeMs = 100;
+    
+    auto start = std::chrono::steady_clock::now();
+    SearchResult result = analyzer.search(pos, limits);
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    
+    EXPECT_TRUE(analyzer.isLegalMove(pos, result.bestMove));
+    EXPECT_LT(std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count(), 500);
+}
+
+TEST_F(SearchTest, StopFlagEndsUnlimitedSearch) {
+    Position pos;
+    SearchResult result;
+    
+    std::thread searchThread([&] { result = analyzer.search(pos, SearchLimits()); });
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    analyzer.stopSearch();
+    searchThread.join();
+    
+    EXPECT_TRUE(analyzer.isLegalMove(pos, result.bestMove));
+    EXPECT_GE(result.depth, 1);
+}
+
+TEST_F(SearchTest, ReportsMateScore) {
+    Position pos("r1bqkb1r/pppp1ppp/2n2n2/4p2Q/2B1P3/8/PPPP1PPP/RNB1K1NR w KQkq - 4 4");
+    SearchLimits limits;
+    limits.depth = 4;
+    
+    SearchResult result = analyzer.search(pos, limits);
+    EXPECT_EQ(result.score, MATE_SCORE - 1);
+    EXPECT_TRUE(isMateScore(result.score));
+}
+
+TEST_F(SearchTest, QuiescenceSeesRecaptureBeyondHorizon) {
+    // At depth 1 Qxd5 wins a pawn unless the recapture exd5 is resolved
+    Position pos("4k3/8/4p3/3p4/8/8/8/3QK3 w - - 0 1");
+    SearchLimits limits;
+    limits.depth = 1;
+    
+    SearchResult result = analyzer.search(pos, limits);
+    EXPECT_NE(result.bestMove, Move(D1, D5));
+    EXPECT_GT(result.score, 500);
+    
+    // Capturing an undefended pawn is still found
+    Position hanging("4k3/8/8/3p4/8/8/8/3QK3 w - - 0 1");
+    EXPECT_EQ(analyzer.search(hanging, limits).bestMove, Move(D1, D5));
+}
+
+TEST_F(SearchTest, LazySmpReturnsMainThreadResult) {
+    analyzer.setThreads(4);
+    EXPECT_EQ(analyzer.getThreads(), 4);
+    
+    Position mate("r1bqkb1r/pppp1ppp/2n2n2/4p2Q/2B1P3/8/PPPP1PPP/RNB1K1NR w KQkq - 4 4");
+    EXPECT_EQ(analyzer.findBestMove(mate, 3), Move(H5, F7));
+    
+    Position pos("r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1");
+    SearchLimits limits;
+    limits.depth = 4;
+    SearchResult result = analyzer.search(pos, limits);
+    EXPECT_EQ(result.depth, 4);
+    ASSERT_FALSE(result.pv.empty());
+    EXPECT_TRUE(analyzer.isLegalMove(pos, result.bestMove));
+    
+    analyzer.setThreads(0);
+    EXPECT_EQ(analyzer.getThreads(), 1);
+}
+
+TEST_F(SearchTest, AspirationWindowsKeepTheResult) {
+    // Without pruning, a window around the last score only saves work: the
+    // move and score match a full-window search at the same depth
+    SearchOptions options;
+    options.nullMove = false;
+    options.lateMoveReductions = false;
+    SearchLimits limits;
+    limits.depth = 5;
+    
+    for (const char* fen : {"r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+                            "r1bq1rk1/pp2bppp/2n1pn2/2pp4/3P4/2PBPN2/PP1N1PPP/R1BQ1RK1 w - - 0 8"}) {
+        Position pos(fen);
+        
+        options.aspirationWindows = true;
+        analyzer.setSearchOptions(options);
+        analyzer.clearHash();
+        SearchResult windowed = analyzer.search(pos, limits);
+        
+        options.aspirationWindows = false;
+        analyzer.setSearchOptions(options);
+        analyzer.clearHash();
+        SearchResult full = analyzer.search(pos, limits);
+        
+        EXPECT_EQ(windowed.bestMove, full.bestMove) << fen;
+        EXPECT_EQ(windowed.score, full.score) << fen;
+        EXPECT_EQ(full.stats.aspirationResearches, 0u) << fen;
+    }
+}
+
+TEST_F(SearchTest, AspirationWindowWidensUntilScoreIsExact) {
+    // A one-centipawn window fails on almost every iteration; the search
+    // must widen it and still land on the full-window score
+    Position pos("r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1");
+    SearchOptions options;
+    options.nullMove = false;
+    options.lateMoveReductions = false;
+    options.aspirationWindows = false;
+    SearchLimits limits;
+    limits.depth = 5;
+    
+    analyzer.setSearchOptions(options);
+    SearchResult full = analyzer.search(pos, limits);
+    
+    options.aspirationWindows = true;
+    options.aspirationDelta = 1;
+    analyzer.setSearchOptions(options);
+    analyzer.clearHash();
+    SearchResult narrow = analyzer.search(pos, limits);
+    
+    EXPECT_GT(narrow.stats.aspirationResearches, 0u);
+    EXPECT_EQ(narrow.score, full.score);
+    EXPECT_EQ(narrow.bestMove, full.bestMove);
+    ASSERT_FALSE(narrow.pv.empty());
+    EXPECT_EQ(narrow.pv[0], narrow.bestMove);
+}
+
+TEST_F(SearchTest, PruningCanBeSwitchedOff) {
+    Position pos("r1bq1rk1/pp2bppp/2n1pn2/2pp4/3P4/2PBPN2/PP1N1PPP/R1BQ1RK1 w - - 0 8");
+    SearchLimits limits;
+    limits.depth = 5;
+    
+    uint64_t prunedNodes = analyzer.search(pos, limits).nodes;
+    
+    SearchOptions options;
+    options.nullMove = false;
+    options.lateMoveReductions = false;
+    analyzer.setSearchOptions(options);
+    EXPECT_FALSE(analyzer.getSearchOptions().nullMove);
+    analyzer.clearHash();
+    uint64_t fullNodes = analyzer.search(pos, limits).nodes;
+    
+    EXPECT_LT(prunedNodes, fullNodes);
+    
+    // Mates are still found with either technique alone
+    Position mate("r1bqkb1r/pppp1ppp/2n2n2/4p2Q/2B1P3/8/PPPP1PPP/RNB1K1NR w KQkq - 4 4");
+    options.nullMove = true;
+    analyzer.setSearchOptions(options);
+    EXPECT_EQ(analyzer.findBestMove(mate, 4), Move(H5, F7));
+    options.nullMove = false;
+    options.lateMoveReductions = true;
+    analyzer.setSearchOptions(options);
+    EXPECT_EQ(analyzer.findBestMove(mate, 4), Move(H5, F7));
+}
+
+TEST_F(SearchTest, NullMoveSkippedInPawnEndings) {
+    // With only kings and pawns, zugzwang is common and a null move is never
+    // tried, so switching it off must not change the search at all
+    Position pos("8/8/p1p5/1p5p/1P5p/8/PPP2K1k/8 w - - 0 1");
+    SearchLimits limits;
+    limits.depth = 7;
+    
+    SearchOptions options;
+    options.lateMoveReductions = false;
+    analyzer.setSearchOptions(options);
+    SearchResult withNullMove = analyzer.search(pos, limits);
+    
+    options.nullMove = false;
+    analyzer.setSearchOptions(options);
+    analyzer.clearHash();
+    SearchResult withoutNullMove = analyzer.search(pos, limits);
+    
+    EXPECT_EQ(withNullMove.nodes, withoutNullMove.nodes);
+    EXPECT_EQ(withNullMove.bestMove, withoutNullMove.bestMove);
+}
+
+TEST_F(SearchTest, AsyncSearchReportsProgressAndStops) {
+    Position pos("r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1");
+    SearchHandle handle = analyzer.startSearch(pos, SearchLimits());
+    ASSERT_TRUE(handle.valid());
+    
+    // Poll until a few iterations have completed
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    while (handle.progress().depth < 3 && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    SearchResult progress = handle.progress();
+    EXPECT_GE(progress.depth, 3);
+    ASSERT_FALSE(progress.pv.empty());
+    EXPECT_EQ(progress.pv[0], progress.bestMove);
+    EXPECT_FALSE(handle.isFinished());
+    
+    handle.stop();
+    std::shared_future<SearchResult> future = handle.future();
+    ASSERT_EQ(future.wait_for(std::chrono::seconds(10)), std::future_status::ready);
+    EXPECT_TRUE(handle.isFinished());
+    
+    SearchResult result = handle.wait();
+    EXPECT_GE(result.depth, progress.depth);
+    EXPECT_TRUE(analyzer.isLegalMove(pos, result.bestMove));
+    EXPECT_EQ(handle.progress().depth, result.depth);
+}
+
+TEST_F(SearchTest, AsyncSearchesRunIndependently) {
+    Position mate("r1bqkb1r/pppp1ppp/2n2n2/4p2Q/2B1P3/8/PPPP1PPP/RNB1K1NR w KQkq - 4 4");
+    Position start;
+    SearchLimits limits;
+    limits.depth = 4;
+    
+    SearchHandle first = analyzer.startSearch(mate, limits);
+    SearchHandle second = analyzer.startSearch(start, limits);
+    EXPECT_EQ(first.wait().bestMove, Move(H5, F7));
+    EXPECT_TRUE(analyzer.isLegalMove(start, second.wait().bestMove));
+    
+    // Dropping a handle cancels its search instead of waiting for it
+    std::shared_future<SearchResult> abandoned;
+    {
+        SearchHandle unlimited = analyzer.startSearch(start, SearchLimits());
+        abandoned = unlimited.future();
+    }
+    EXPECT_EQ(abandoned.wait_for(std::chrono::seconds(0)), std::future_status::ready);
+    
+    SearchHandle empty;
+    EXPECT_FALSE(empty.valid());
+    EXPECT_EQ(empty.wait().bestMove, NULL_MOVE);
+}
+
+TEST_F(SearchTest, SettingsWaitForRunningSearches) {
+    Position pos("r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1");
+    analyzer.setThreads(2);
+    SearchHandle handle = analyzer.startSearch(pos, SearchLimits());
+    
+    // The running search keeps the settings it started with
+    analyzer.setThreads(1);
+    SearchOptions options;
+    options.nullMove = false;
+    analyzer.setSearchOptions(options);
+    
+    // The table is only resized once the search is done with it
+    std::atomic<bool> resized(false);
+    std::thread resizer([this, &resized] {
+        analyzer.setHashSize(1);
+        resized = true;
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    EXPECT_FALSE(resized);
+    EXPECT_FALSE(handle.isFinished());
+    
+    handle.stop();
+    SearchResult result = handle.wait();
+    resizer.join();
+    EXPECT_TRUE(resized);
+    EXPECT_TRUE(analyzer.isLegalMove(pos, result.bestMove));
+}
+
+TEST_F(SearchTest, SettingsCanChangeWhileSearchesStart) {
+    Position pos("r1bqkbnr/pppp1ppp/2n5/4p3/4P3/5N2/PPPP1PPP/RNBQKB1R w KQkq - 2 3");
+    SearchLimits limits;
+    limits.depth = 3;
+    
+    std::thread searcher([this, &pos, &limits] {
+        for (int i = 0; i < 10; ++i) {
+            SearchResult result = analyzer.search(pos, limits);
+            EXPECT_TRUE(analyzer.isLegalMove(pos, result.bestMove));
+        }
+    });
+    for (int i = 0; i < 100; ++i) {
+        analyzer.setThreads(1 + i % 3);
+        SearchOptions options;
+        options.nullMove = i % 2 == 0;
+        analyzer.setSearchOptions(options);
+    }
+    searcher.join();
+    EXPECT_EQ(analyzer.getThreads(), 1);
+    EXPECT_FALSE(analyzer.getSearchOptions().nullMove);
+}
+
+TEST_F(SearchTest, MultiPVRanksDistinctRootMoves) {
+    Position pos("r1bqkb1r/pppp1ppp/2n2n2/4p2Q/2B1P3/8/PPPP1PPP/RNB1K1NR w KQkq - 4 4");
+    std::vector<PVLine> lines = analyzer.findTopMoves(pos, 4, 4);
+    ASSERT_EQ(lines.size(), 4u);
+    
+    // The mate comes first and is the only winning line
+    EXPECT_EQ(lines[0].move, Move(H5, F7));
+    EXPECT_TRUE(isMateScore(lines[0].score));
+    
+    for (size_t i = 0; i < lines.size(); ++i) {
+        EXPECT_TRUE(analyzer.isLegalMove(pos, lines[i].move));
+        ASSERT_FALSE(lines[i].pv.empty());
+        EXPECT_EQ(lines[i].pv[0], lines[i].move);
+        for (size_t j = 0; j < i; ++j) {
+            EXPECT_NE(lines[i].move, lines[j].move);
+            EXPECT_GE(lines[j].score, lines[i].score);
+        }
+    }
+    
+    // Never more lines than legal moves
+    Position kings("8/8/8/8/8/8/8/K6k w - - 0 1");
+    EXPECT_EQ(analyzer.findTopMoves(kings, 10, 3).size(), 3u);
+    
+    // A single-line search reports its move as the only line
+    SearchLimits limits;
+    limits.depth = 3;
+    SearchResult result = analyzer.search(pos, limits);
+    ASSERT_EQ(result.lines.size(), 1u);
+    EXPECT_EQ(result.lines[0].move, result.bestMove);
+}
+
+TEST_F(SearchTest, ReportsConsistentStatistics) {
+    Position pos("r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1");
+    SearchLimits limits;
+    limits.depth = 6;
+    SearchResult result = analyzer.search(pos, limits);
+    const SearchStats& stats = result.stats;
+    
+    EXPECT_EQ(stats.nodes, result.nodes);
+    EXPECT_GT(stats.qnodes, 0u);
+    EXPECT_LT(stats.qnodes, stats.nodes);
+    
+    // Every full-width node probes the table once
+    EXPECT_LE(stats.ttProbes, stats.nodes - stats.qnodes);
+    EXPECT_LE(stats.ttHits, stats.ttProbes);
+    EXPECT_LE(stats.ttCutoffs, stats.ttHits);
+    EXPECT_GT(stats.ttCutoffs, 0u);
+    
+    EXPECT_GT(stats.betaCutoffs, 0u);
+    EXPECT_LE(stats.firstMoveCutoffs, stats.betaCutoffs);
+    EXPECT_GT(stats.firstMoveCutoffRate(), 0.5);
+    
+    ASSERT_EQ(stats.iterations.size(), 6u);
+    uint64_t iterationNodes = 0;
+    for (size_t i = 0; i < stats.iterations.size(); ++i) {
+        EXPECT_EQ(stats.iterations[i].depth, static_cast<int>(i) + 1);
+        iterationNodes += stats.iterations[i].nodes;
+    }
+    EXPECT_EQ(iterationNodes, stats.nodes);
+    EXPECT_GT(stats.branchingFactor(), 1.0);
+    
+    // Helper threads' counters are merged into the main thread's
+    analyzer.setThreads(3);
+    analyzer.clearHash();
+    SearchResult smp = analyzer.search(pos, limits);
+    EXPECT_EQ(smp.stats.nodes, smp.nodes);
+    EXPECT_EQ(smp.stats.iterations.size(), 6u);
+}
\ No newline at end of file
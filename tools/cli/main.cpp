@@ -12,7 +12,8 @@ void printUsage(const char* programName) {
     std::cout << "Commands:\n";
     std::cout << "  analyze <fen>     Analyze a position and explain all legal moves\n";
     std::cout << "  explain <fen> <move>  Explain a specific move in a position\n";
-    std::cout << "  best <fen> [depth]    Find the best move in a position\n";
+    std::cout << "  best <fen> [depth] [threads]  Find the best move in a position\n";
+    std::cout << "  top <fen> [count] [depth]     Rank the best moves with scores and lines\n";
     std::cout << "  game <pgn-file>       Analyze all moves in a PGN game\n";
     std::cout << "  help                  Show this help message\n\n";
     std::cout << "Examples:\n";
@@ -87,14 +88,19 @@ void explainMove(const std::string& fen, const std::string& moveStr) {
     }
 }
 
-void findBestMove(const std::string& fen, int depth = 6) {
+void findBestMove(const std::string& fen, int depth = 6, int threads = 1) {
     try {
         ChessAnalyzer analyzer;
+        analyzer.setThreads(threads);
         Position pos(fen == "startpos" ? "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1" : fen);
         
-        std::cout << "\nSearching for best move (depth " << depth << ")...\n";
+        std::cout << "\nSearching for best move (depth " << depth << ", "
+                  << analyzer.getThreads() << " thread" << (analyzer.getThreads() == 1 ? "" : "s") << ")...\n";
         
-        Move bestMove = analyzer.findBestMove(pos, depth);
+        SearchLimits limits;
+        limits.depth = depth;
+        SearchResult result = analyzer.search(pos, limits);
+        Move bestMove = result.bestMove;
         
         if (bestMove.isNull()) {
             std::cout << "No legal moves available!\n";
@@ -111,6 +117,55 @@ void findBestMove(const std::string& fen, int depth = 6) {
         int evaluation = analyzer.evaluatePosition(afterMove);
         std::cout << "Evaluation after move: " << evaluation << " centipawns\n";
         
+        const SearchStats& stats = result.stats;
+        std::cout << "\nSearch Statistics\n";
+        std::cout << "=================\n";
+        std::cout << "Nodes: " << stats.nodes << " (" << stats.qnodes << " quiescence), "
+                  << stats.nodesPerSecond() << " nps in " << stats.timeMs << " ms\n";
+        std::cout << "TT: " << stats.ttProbes << " probes, " << stats.ttHits << " hits, "
+                  << stats.ttCutoffs << " cutoffs\n";
+        std::cout << std::fixed << std::setprecision(1)
+                  << "First-move cutoffs: " << stats.firstMoveCutoffRate() * 100 << "%, "
+                  << "branching factor: " << std::setprecision(2) << stats.branchingFactor() << "\n";
+        for (const auto& iteration : stats.iterations) {
+            std::cout << "  depth " << std::setw(2) << iteration.depth << ": "
+                      << iteration.nodes << " nodes, " << iteration.timeMs << " ms\n";
+        }
+        
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << "\n";
+    }
+}
+
+void findTopMoves(const std::string& fen, int count = 5, int depth = 6) {
+    try {
+        ChessAnalyzer analyzer;
+        Position pos(fen == "startpos" ? "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1" : fen);
+        
+        std::cout << "\nRanking the top " << count << " moves (depth " << depth << ")...\n\n";
+        
+        auto lines = analyzer.findTopMoves(pos, count, depth);
+        if (lines.empty()) {
+            std::cout << "No legal moves available!\n";
+            return;
+        }
+        
+        int rank = 1;
+        for (const auto& line : lines) {
+            std::cout << std::right << std::setw(2) << rank++ << ". "
+                      << std::left << std::setw(8) << line.move.toAlgebraic(pos);
+            if (isMateScore(line.score)) {
+                int plies = MATE_SCORE - std::abs(line.score);
+                std::cout << std::setw(10) << ((line.score > 0 ? "mate " : "mated ") + std::to_string((plies + 1) / 2));
+            } else {
+                std::cout << std::showpos << std::setw(10) << line.score << std::noshowpos;
+            }
+            for (const auto& move : line.pv) {
+                std::cout << move.toUCI() << " ";
+            }
+            std::cout << "\n";
+        }
+        
     } catch (const std::exception& e) {
         std::cerr << "Error: " << e.what() << "\n";
     }
@@ -136,8 +191,14 @@ int main(int argc, char* argv[]) {
         explainMove(argv[2], argv[3]);
     }
     else if (command == "best" && argc >= 3) {
-        int depth = (argc >= 4) ? std::stoi(argv[4]) : 6;
-        findBestMove(argv[2], depth);
+        int depth = (argc >= 4) ? std::stoi(argv[3]) : 6;
+        int threads = (argc >= 5) ? std::stoi(argv[4]) : 1;
+        findBestMove(argv[2], depth, threads);
+    }
+    else if (command == "top" && argc >= 3) {
+        int count = (argc >= 4) ? std::stoi(argv[3]) : 5;
+        int depth = (argc >= 5) ? std::stoi(argv[4]) : 6;
+        findTopMoves(argv[2], count, depth);
     }
     else if (command == "game" && argc >= 3) {
         std::cout << "PGN analysis not yet implemented\n";